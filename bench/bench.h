@@ -0,0 +1,37 @@
+#pragma once
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace Bench {
+
+    using Clock = std::chrono::steady_clock;
+
+    /// Calls fn `iterations` times and returns the mean time of one call in nanoseconds.
+    template <typename Fn>
+    double timePerCall(int iterations, Fn&& fn)
+    {
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; ++i)
+            fn();
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start);
+        return elapsed.count() / iterations;
+    }
+
+    /// Per-tick cost of moving every enemy, across board sizes and enemy counts.
+    void boardTick();
+    /// Dense (chunked) versus sparse (hashed) board storage across entity densities.
+    void boardBackends();
+    /// AI tick over 100k enemies: heap objects behind virtual calls versus the component store.
+    void entityTick();
+    /// Row-major versus Z-order tiles inside a chunk, for the board's window and neighbour reads.
+    void tileLayout();
+    /// Board neighbour and distance math with run-time sizes versus the specialised grids.
+    void topology();
+    /// A* queries per second on 256 x 256 walled boards, short chases and across the board.
+    void pathFind();
+    /// Flow field updates repaired versus rebuilt, and a tick of chasers on the field versus A*.
+    void flowField();
+    /// Two-phase enemy update across thread counts, checking every count ends on the same board.
+    void enemyTick();
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#define SDL_MAIN_HANDLED
+#include "bench.h"
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * Runs every benchmark, or only the ones named on the command line.
+ */
+int main(int argc, char* argv[]) {
+
+  const std::vector<std::pair<std::string, std::function<void()>>> benches = {
+    {"boardTick", Bench::boardTick},
+    {"boardBackends", Bench::boardBackends},
+    {"entityTick", Bench::entityTick},
+    {"tileLayout", Bench::tileLayout},
+    {"topology", Bench::topology},
+    {"pathFind", Bench::pathFind},
+    {"flowField", Bench::flowField},
+    {"enemyTick", Bench::enemyTick},
+  };
+
+  for (const auto& [name, run] : benches)
+  {
+    bool selected = argc < 2;
+    for (int i = 1; i < argc; ++i)
+      if (name == argv[i]) selected = true;
+
+    if (!selected) continue;
+
+    std::cout << "== " << name << "\n";
+    run();
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "bench.h"
+#include "core/board.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+    void populate(Core::Board& board, int count, std::mt19937& rng)
+    {
+        const Core::Size size = board.getBoardSizes();
+
+        for (int placed = 0; placed < count; )
+        {
+            Utils::Position pos{static_cast<int>(rng() % size.height), static_cast<int>(rng() % size.width)};
+            if (!board.isTileEmpty(pos)) continue;
+
+            board.setEntityAt(pos, board.getRegistry().create<Entities::Enemy>(Utils::intern("Bench"), Entities::Stats(10, 2, 2), pos));
+            ++placed;
+        }
+    }
+}
+
+void Bench::boardBackends()
+{
+    const int boardSize = 1024;
+    const double densities[] = {0.0001, 0.001, 0.01, 0.1};
+    const int lookups = 1 << 20;
+    const int queries = 1 << 14;
+
+    std::cout << "backend\tdensity\tentities\tns/lookup\tns/neighbours\tns/query(r=8)\ttile KB\n";
+
+    for (double density : densities)
+    {
+        const int count = static_cast<int>(density * boardSize * boardSize);
+
+        for (auto backend : {Core::BoardBackend::DENSE, Core::BoardBackend::SPARSE})
+        {
+            Core::EntityRegistry registry;
+            Core::Board board(registry, {boardSize, boardSize}, {}, backend);
+            std::mt19937 rng(7);
+            populate(board, count, rng);
+
+            std::vector<Utils::Position> probes(lookups);
+            for (auto& p : probes)
+                p = {static_cast<int>(rng() % boardSize), static_cast<int>(rng() % boardSize)};
+
+            size_t sink = 0;
+            size_t i = 0;
+
+            double lookupNs = timePerCall(lookups, [&] {
+                sink += static_cast<size_t>(board.getEntityTypeAt(probes[i++ % probes.size()], Core::TileLayer::ACTOR));
+            });
+
+            double neighboursNs = timePerCall(lookups, [&] {
+                sink += board.getWalkableNeighbours(probes[i++ % probes.size()]);
+            });
+
+            Core::EntityId found[512];
+            double queryNs = timePerCall(queries, [&] {
+                sink += board.queryRadius(probes[i++ % probes.size()], 8, Entities::typeMaskOf(Entities::EntityType::ENEMY), found);
+            });
+
+            std::cout << (backend == Core::BoardBackend::DENSE ? "dense" : "sparse") << "\t"
+                      << density * 100 << "%\t" << count << "\t\t"
+                      << lookupNs << "\t\t" << neighboursNs << "\t\t" << queryNs << "\t\t"
+                      << board.getTileMemoryBytes() / 1024
+                      << (sink == 42 ? " " : "") << "\n";
+        }
+    }
+}
\ No newline at end of file
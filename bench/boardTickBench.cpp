@@ -0,0 +1,52 @@
+#include "bench.h"
+#include "core/board.h"
+#include "utils/util.h"
+#include <random>
+
+namespace {
+
+    /// Same board work as EntityManager::enemyAlgorithm: every enemy tries one random step.
+    void tick(Core::Board& board, std::mt19937& rng)
+    {
+        const Core::Size size = board.getBoardSizes();
+
+        for (size_t i = 0; i < board.enemyCount(); ++i)
+        {
+            auto e = board.getRegistry().get(board.getEntitiesOfType(Entities::EntityType::ENEMY)[i]);
+            auto pos = e->getPos();
+            auto target = Utils::getDirection(pos.x, pos.y, static_cast<Utils::Direction>(rng() % 4), size);
+
+            board.moveEntity(pos, target);
+        }
+    }
+}
+
+void Bench::boardTick()
+{
+    const int sizes[] = {64, 512, 4096};
+    const int enemyCounts[] = {100, 1000, 4000};
+    const int ticks = 200;
+
+    std::cout << "board\tenemies\tns/tick\tns/enemy\n";
+
+    for (int boardSize : sizes)
+    {
+        for (int enemies : enemyCounts)
+        {
+            Core::EntityRegistry registry;
+            Core::Board board(registry, {boardSize, boardSize});
+            std::mt19937 rng(42);
+
+            Utils::Position pos;
+            for (int i = 0; i < enemies && Utils::generateRandomPosition(board, pos); ++i)
+            {
+                auto enemy = registry.create<Entities::Enemy>(Utils::intern("Bench"), Entities::Stats(10, 2, 2), Utils::Position{0,0});
+                board.setEntityAt(pos, enemy);
+            }
+
+            double ns = timePerCall(ticks, [&] { tick(board, rng); });
+            std::cout << boardSize << "x" << boardSize << "\t" << enemies << "\t"
+                      << static_cast<long long>(ns) << "\t" << static_cast<long long>(ns / enemies) << "\n";
+        }
+    }
+}
\ No newline at end of file
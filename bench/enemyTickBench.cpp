@@ -0,0 +1,73 @@
+#include "bench.h"
+#include "core/game.h"
+#include <random>
+
+namespace {
+
+    struct TickResult
+    {
+        double ms;
+        std::uint64_t checksum;
+    };
+
+    /// side x side board, 10% walls and enemies on enemyShare of the tiles, ticks enemy updates
+    /// with every enemy due. The player is boxed in by walls so no fight stops the ticks.
+    TickResult run(int threads, int side, double enemyShare, int ticks)
+    {
+        Core::Game g;
+        g.config.board.width = g.config.board.height = side;
+        g.board = std::make_unique<Core::Board>(g.registry, g.config.board);
+        g.entityManager = std::make_unique<Core::EntityManager>(threads);
+
+        std::mt19937 rng(13);
+        for (int i = 0; i < side * side / 10; ++i)
+            g.board->setTerrainAt({static_cast<int>(rng() % side), static_cast<int>(rng() % side)}, Core::Terrain::WALL);
+
+        const Utils::Position center{side / 2, side / 2};
+        g.player = g.registry.create<Entities::Player>(center);
+        g.board->setTerrainAt(center, Core::Terrain::FLOOR);
+        g.board->setEntityAt(center, g.player);
+        for (int dir = 0; dir < 4; ++dir)
+            g.board->setTerrainAt(Utils::getDirection(center.x, center.y, static_cast<Utils::Direction>(dir), g.config.board), Core::Terrain::WALL);
+
+        const int enemies = static_cast<int>(enemyShare * side * side);
+        for (int placed = 0; placed < enemies;)
+        {
+            Utils::Position pos{static_cast<int>(rng() % side), static_cast<int>(rng() % side)};
+            if (!g.board->isTileEmpty(pos)) continue;
+            g.board->setEntityAt(pos, g.registry.create<Entities::Enemy>(Utils::intern("Bench"), Entities::Stats(5, 1, 1), Utils::Position{0, 0}));
+            ++placed;
+        }
+
+        auto& c = g.registry.getComponents();
+        double ns = Bench::timePerCall(ticks, [&] {
+            for (std::uint32_t i = 0; i < c.size(); ++i) c.nextActionTimes[i] = 0;
+            g.entityManager->enemyAlgorithm(g);
+        });
+
+        // Where every entity ended up, to check the thread count changed nothing.
+        std::uint64_t checksum = 0;
+        for (std::uint32_t i = 0; i < c.size(); ++i)
+            checksum = checksum * 1000003 + static_cast<std::uint64_t>(c.positions[i].x) * 65536 + c.positions[i].y;
+        return {ns / 1e6, checksum};
+    }
+}
+
+void Bench::enemyTick()
+{
+    std::cout << "board\tenemies\tthreads\tms/tick\tsame as 1 thread\n";
+
+    for (int side : {256, 1024})
+    {
+        const double share = 0.05;
+        const TickResult single = run(1, side, share, 32);
+        std::cout << side << "\t" << static_cast<int>(share * side * side) << "\t1\t" << single.ms << "\t-\n";
+
+        for (int threads : {2, 4, 8})
+        {
+            const TickResult result = run(threads, side, share, 32);
+            std::cout << side << "\t" << static_cast<int>(share * side * side) << "\t" << threads << "\t"
+                      << result.ms << "\t" << (result.checksum == single.checksum ? "yes" : "NO") << "\n";
+        }
+    }
+}
\ No newline at end of file
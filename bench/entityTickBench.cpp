@@ -0,0 +1,151 @@
+#include "bench.h"
+#include "core/entityRegistry.h"
+#include "entities/enemy.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// An enemy as it was stored before the component store: one heap object per entity,
+    /// with its data read through virtual calls.
+    class ObjectEntity
+    {
+    public:
+        Uint32 lastMoveTime = 0;
+
+        virtual const Utils::Position& getPos() = 0;
+        virtual void setPos(Utils::Position p) = 0;
+        virtual Entities::EntityType getType() = 0;
+        virtual ~ObjectEntity() = default;
+
+    protected:
+        Utils::Position pos;
+        Entities::EntityType type;
+        std::string name;
+    };
+
+    class ObjectEnemy : public ObjectEntity
+    {
+    public:
+        ObjectEnemy(const std::string& _name, Entities::Stats _stats, Utils::Position _pos) : stats(_stats)
+        {
+            type = Entities::EntityType::ENEMY;
+            name = _name;
+            pos = _pos;
+        }
+
+        const Utils::Position& getPos() override { return pos; }
+        void setPos(Utils::Position p) override { pos = p; }
+        Entities::EntityType getType() override { return type; }
+
+    private:
+        Entities::Stats stats;
+    };
+
+    constexpr int boardSize = 4096;
+    constexpr std::uint32_t moveDelay = 200;
+    constexpr std::uint32_t tickMs = 50;
+
+    /// One AI decision: step towards the target when close, otherwise drift along a fixed pattern.
+    Utils::Position step(Utils::Position pos, Utils::Position target, std::uint32_t salt)
+    {
+        int dx = target.x - pos.x;
+        int dy = target.y - pos.y;
+
+        if (dx * dx + dy * dy <= 25)
+        {
+            pos.x += (dx > 0) - (dx < 0);
+            pos.y += (dy > 0) - (dy < 0);
+        }
+        else
+        {
+            pos.x += static_cast<int>(salt & 1) * 2 - 1;
+            pos.y += static_cast<int>((salt >> 1) & 1) * 2 - 1;
+        }
+
+        pos.x = (pos.x + boardSize) % boardSize;
+        pos.y = (pos.y + boardSize) % boardSize;
+        return pos;
+    }
+
+    double objectTick(std::vector<std::unique_ptr<ObjectEntity>>& entities, int ticks)
+    {
+        std::uint32_t now = 0;
+        const Utils::Position target{boardSize / 2, boardSize / 2};
+
+        return Bench::timePerCall(ticks, [&] {
+            now += tickMs;
+            for (auto& e : entities)
+            {
+                if (e->getType() != Entities::EntityType::ENEMY) continue;
+                if (now - e->lastMoveTime <= moveDelay) continue;
+
+                e->setPos(step(e->getPos(), target, now ^ e->lastMoveTime));
+                e->lastMoveTime = now;
+            }
+        });
+    }
+
+    /// Same filter as EntityManager::enemyAlgorithm, streaming the registry's component arrays.
+    double componentTick(Core::ComponentStore& c, int ticks)
+    {
+        std::uint32_t now = 0;
+        const Utils::Position target{boardSize / 2, boardSize / 2};
+
+        return Bench::timePerCall(ticks, [&] {
+            now += tickMs;
+
+            const Entities::EntityType* types = c.types.data();
+            Utils::Position* positions = c.positions.data();
+            std::uint32_t* nextActionTimes = c.nextActionTimes.data();
+            const std::uint32_t count = static_cast<std::uint32_t>(c.size());
+
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                if (types[i] != Entities::EntityType::ENEMY) continue;
+                if (static_cast<std::int32_t>(now - nextActionTimes[i]) <= 0) continue;
+
+                positions[i] = step(positions[i], target, now ^ nextActionTimes[i]);
+                nextActionTimes[i] = now + moveDelay;
+            }
+        });
+    }
+}
+
+void Bench::entityTick()
+{
+    const int counts[] = {1000, 10000, 100000};
+    const int ticks = 200;
+
+    std::cout << "enemies\tobjects ns/enemy\tobjects (shuffled) ns/enemy\tcomponents ns/enemy\n";
+
+    for (int count : counts)
+    {
+        std::mt19937 rng(11);
+        std::vector<Utils::Position> spawns(count);
+        for (auto& p : spawns)
+            p = {static_cast<int>(rng() % boardSize), static_cast<int>(rng() % boardSize)};
+
+        std::vector<std::unique_ptr<ObjectEntity>> objects;
+        objects.reserve(count);
+        for (const auto& p : spawns)
+            objects.push_back(std::make_unique<ObjectEnemy>("Bench", Entities::Stats(10, 2, 2), p));
+
+        double objectNs = objectTick(objects, ticks);
+
+        // After a while of spawns and despawns the iteration order no longer follows allocation order.
+        std::shuffle(objects.begin(), objects.end(), rng);
+        double shuffledNs = objectTick(objects, ticks);
+
+        Core::EntityRegistry registry;
+        for (const auto& p : spawns)
+            registry.create<Entities::Enemy>(Utils::intern("Bench"), Entities::Stats(10, 2, 2), p);
+
+        double componentNs = componentTick(registry.getComponents(), ticks);
+
+        std::cout << count << "\t" << objectNs / count << "\t\t\t" << shuffledNs / count
+                  << "\t\t\t\t" << componentNs / count << "\n";
+    }
+}
\ No newline at end of file
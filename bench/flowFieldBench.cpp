@@ -0,0 +1,170 @@
+#include "bench.h"
+#include "core/board.h"
+#include "systems/flowField.h"
+#include "systems/pathFinder.h"
+#include "utils/util.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+    constexpr int side = 256;
+    constexpr int radius = 24;
+
+    Core::Size boardSize(Core::Topology topology)
+    {
+        Core::Size size;
+        size.width = size.height = side;
+        size.topology = topology;
+        return size;
+    }
+
+    /// obstacle share of the tiles turned to walls, the middle of the board kept clear for the goal.
+    void buildWalls(Core::Board& board, double obstacles, std::mt19937& rng)
+    {
+        const int walls = static_cast<int>(obstacles * side * side);
+        for (int i = 0; i < walls; ++i)
+            board.setTerrainAt({static_cast<int>(rng() % side), static_cast<int>(rng() % side)}, Core::Terrain::WALL);
+        board.setTerrainAt({side / 2, side / 2}, Core::Terrain::FLOOR);
+    }
+
+    /// Floor tile next to pos in a random direction, pos itself when the one picked is a wall.
+    Utils::Position wander(const Core::Board& board, Utils::Position pos, std::mt19937& rng)
+    {
+        auto next = Utils::getDirection(pos.x, pos.y, static_cast<Utils::Direction>(rng() % 4), board.getBoardSizes());
+        return board.getTerrainAt(next) == Core::Terrain::WALL ? pos : next;
+    }
+
+    /// The goal taking one step a tick: repairing the field against building it anew.
+    void goalMoves(Core::Topology topology, double obstacles)
+    {
+        Core::EntityRegistry registry;
+        Core::Board board(registry, boardSize(topology));
+        std::mt19937 rng(5);
+        buildWalls(board, obstacles, rng);
+
+        const int count = 2048;
+        std::vector<Utils::Position> goals{{side / 2, side / 2}};
+        while (static_cast<int>(goals.size()) < count) goals.push_back(wander(board, goals.back(), rng));
+
+        Systems::FlowField field(radius);
+        long repaired = 0;
+        size_t i = 0;
+        double repair = Bench::timePerCall(count, [&] {
+            field.setGoal(board, goals[i++]);
+            repaired += field.getLastRepairCount();
+        });
+
+        i = 0;
+        double rebuild = Bench::timePerCall(count, [&] {
+            Systems::FlowField fresh(radius);
+            fresh.setGoal(board, goals[i++]);
+        });
+
+        std::cout << "goal step\t" << obstacles * 100 << "%\t" << repair / 1000 << "\t" << rebuild / 1000
+                  << "\t" << repaired / count << "\n";
+    }
+
+    /// A few walls raised or torn down near the goal each tick, read back from the journal.
+    void wallChanges(Core::Topology topology, double obstacles)
+    {
+        Core::EntityRegistry registry;
+        Core::Board board(registry, boardSize(topology));
+        board.getJournal().setEnabled(true);
+        std::mt19937 rng(7);
+        buildWalls(board, obstacles, rng);
+        board.getJournal().nextTick();
+
+        const Utils::Position goal{side / 2, side / 2};
+        Systems::FlowField field(radius);
+        field.setGoal(board, goal);
+
+        auto toggle = [&] {
+            for (int k = 0; k < 4; ++k)
+            {
+                Utils::Position pos{goal.x + static_cast<int>(rng() % 21) - 10, goal.y + static_cast<int>(rng() % 21) - 10};
+                if (pos == goal) continue;
+                board.setTerrainAt(pos, board.getTerrainAt(pos) == Core::Terrain::WALL ? Core::Terrain::FLOOR : Core::Terrain::WALL);
+            }
+        };
+
+        // Toggling the board is timed on both sides, so only the field work differs.
+        const int count = 2048;
+        long repaired = 0;
+        double repair = Bench::timePerCall(count, [&] {
+            toggle();
+            field.applyChanges(board, board.getJournal().getChanges());
+            board.getJournal().nextTick();
+            repaired += field.getLastRepairCount();
+        });
+
+        double rebuild = Bench::timePerCall(count, [&] {
+            toggle();
+            Systems::FlowField fresh(radius);
+            fresh.setGoal(board, goal);
+            board.getJournal().nextTick();
+        });
+
+        std::cout << "4 walls\t" << obstacles * 100 << "%\t" << repair / 1000 << "\t" << rebuild / 1000
+                  << "\t" << repaired / count << "\n";
+    }
+
+    /// One enemy tick: the player steps, then every chaser within chase range picks its move,
+    /// from the shared field or from an A* search of its own.
+    void chasers(Core::Topology topology, int count)
+    {
+        Core::EntityRegistry registry;
+        Core::Board board(registry, boardSize(topology));
+        std::mt19937 rng(11);
+        buildWalls(board, 0.2, rng);
+
+        Utils::Position player{side / 2, side / 2};
+        std::vector<Utils::Position> enemies;
+        while (static_cast<int>(enemies.size()) < count)
+        {
+            Utils::Position pos{player.x + static_cast<int>(rng() % 11) - 5, player.y + static_cast<int>(rng() % 11) - 5};
+            if (board.getTerrainAt(pos) == Core::Terrain::FLOOR) enemies.push_back(pos);
+        }
+
+        const int ticks = 256;
+        std::vector<Utils::Position> players{player};
+        while (static_cast<int>(players.size()) < ticks) players.push_back(wander(board, players.back(), rng));
+
+        Systems::FlowField field(radius);
+        long moves = 0;
+        int t = 0;
+        double shared = Bench::timePerCall(ticks, [&] {
+            field.setGoal(board, players[t++]);
+            Utils::Direction dir;
+            for (const auto& pos : enemies)
+                moves += field.stepFrom(pos, dir);
+        });
+
+        Systems::PathFinder finder;
+        t = 0;
+        double searched = Bench::timePerCall(ticks, [&] {
+            const Utils::Position goal = players[t++];
+            for (const auto& pos : enemies)
+                moves += finder.findPath(board, pos, goal, 12) && !finder.getPath().empty();
+        });
+
+        std::cout << count << " chasers\t20%\t" << shared / 1000 << "\t" << searched / 1000
+                  << "\t" << 100 * moves / (2L * ticks * count) << "% moving\n";
+    }
+}
+
+void Bench::flowField()
+{
+    for (auto topology : {Core::Topology::WRAP, Core::Topology::BOUNDED})
+    {
+        std::cout << (topology == Core::Topology::WRAP ? "wrap" : "bounded") << " 256 x 256, radius " << radius << "\n";
+        std::cout << "update\twalls\tfield us\trebuild / A* us\trepaired tiles\n";
+        for (double obstacles : {0.1, 0.3})
+        {
+            goalMoves(topology, obstacles);
+            wallChanges(topology, obstacles);
+        }
+        for (int count : {16, 128, 512})
+            chasers(topology, count);
+    }
+}
\ No newline at end of file
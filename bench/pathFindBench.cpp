@@ -0,0 +1,79 @@
+#include "bench.h"
+#include "core/board.h"
+#include "systems/pathFinder.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+    struct Query
+    {
+        Utils::Position from;
+        Utils::Position to;
+    };
+
+    /// Walled board of side x side, obstacle share of the tiles turned to walls.
+    void buildWalls(Core::Board& board, int side, double obstacles, std::mt19937& rng)
+    {
+        const int walls = static_cast<int>(obstacles * side * side);
+        for (int i = 0; i < walls; ++i)
+            board.setTerrainAt({static_cast<int>(rng() % side), static_cast<int>(rng() % side)}, Core::Terrain::WALL);
+    }
+
+    /// Pairs of floor tiles, at most reach tiles apart on each axis.
+    std::vector<Query> makeQueries(const Core::Board& board, int side, int reach, int count, std::mt19937& rng)
+    {
+        std::vector<Query> queries;
+        while (static_cast<int>(queries.size()) < count)
+        {
+            Utils::Position from{static_cast<int>(rng() % side), static_cast<int>(rng() % side)};
+            Utils::Position to{(from.x + static_cast<int>(rng() % (2 * reach + 1)) - reach + side) % side,
+                               (from.y + static_cast<int>(rng() % (2 * reach + 1)) - reach + side) % side};
+            if (board.isTileWalkable(from) && board.isTileWalkable(to)) queries.push_back({from, to});
+        }
+        return queries;
+    }
+
+    void run(Core::Topology topology, double obstacles, int reach, int radius)
+    {
+        const int side = 256;
+        Core::Size size;
+        size.width = size.height = side;
+        size.topology = topology;
+
+        Core::EntityRegistry registry;
+        Core::Board board(registry, size);
+        std::mt19937 rng(3);
+        buildWalls(board, side, obstacles, rng);
+
+        const int count = 4096;
+        auto queries = makeQueries(board, side, reach, count, rng);
+
+        Systems::PathFinder finder;
+        long found = 0, expanded = 0;
+        size_t i = 0;
+        double ns = Bench::timePerCall(count, [&] {
+            const Query& q = queries[i++ % queries.size()];
+            found += finder.findPath(board, q.from, q.to, radius);
+            expanded += finder.getExpanded();
+        });
+
+        std::cout << (topology == Core::Topology::WRAP ? "wrap" : "bounded") << "\t" << obstacles * 100 << "%\t"
+                  << reach << "\t" << radius << "\t" << 1e9 / ns << "\t" << expanded / count
+                  << "\t" << 100 * found / count << "%\n";
+    }
+}
+
+void Bench::pathFind()
+{
+    std::cout << "topology\twalls\treach\tradius\tqueries/s\texpanded\tfound\n";
+
+    for (auto topology : {Core::Topology::WRAP, Core::Topology::BOUNDED})
+        for (double obstacles : {0.1, 0.2, 0.3})
+        {
+            // Chasing enemies: the player a few tiles away, searched in a small window.
+            run(topology, obstacles, 5, 12);
+            // Anywhere to anywhere, the window covering the whole board.
+            run(topology, obstacles, 128, 256);
+        }
+}
\ No newline at end of file
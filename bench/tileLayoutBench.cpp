@@ -0,0 +1,162 @@
+#include "bench.h"
+#include "entities/entityType.h"
+#include "utils/morton.h"
+#include "utils/position.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+    enum class Layout { ROW_MAJOR, MORTON, MORTON_TABLE };
+
+    /// Z-order bits of each in-chunk row and column, so an index is two loads and an or.
+    struct MortonTable
+    {
+        std::uint16_t row[32];
+        std::uint16_t col[32];
+    };
+
+    constexpr MortonTable mortonTable = [] {
+        MortonTable t{};
+        for (std::uint32_t i = 0; i < 32; ++i)
+        {
+            t.row[i] = static_cast<std::uint16_t>(Utils::mortonEncode(i, 0));
+            t.col[i] = static_cast<std::uint16_t>(Utils::mortonEncode(0, i));
+        }
+        return t;
+    }();
+
+    /// Chunked tile grid shaped like the DENSE board (32 x 32 chunks of slots and types),
+    /// with the tile order inside a chunk as the only difference.
+    template <Layout L>
+    class TileGrid
+    {
+    public:
+        static constexpr int shift = 5;
+        static constexpr int size = 1 << shift;
+
+        struct Chunk
+        {
+            int slots[size * size];
+            Entities::EntityType types[size * size];
+        };
+
+        explicit TileGrid(int _side) : side(_side), chunkCols(_side >> shift), chunks(chunkCols * chunkCols)
+        {
+            for (auto& c : chunks)
+            {
+                c = std::make_unique<Chunk>();
+                for (auto& t : c->types) t = Entities::EntityType::NONE;
+            }
+        }
+
+        static int local(int x, int y)
+        {
+            const int lx = x & (size - 1), ly = y & (size - 1);
+            if constexpr (L == Layout::MORTON) return static_cast<int>(Utils::mortonEncode(lx, ly));
+            else if constexpr (L == Layout::MORTON_TABLE) return mortonTable.row[lx] | mortonTable.col[ly];
+            else return (lx << shift) | ly;
+        }
+
+        const Chunk* chunkOf(int x, int y) const { return chunks[(x >> shift) * chunkCols + (y >> shift)].get(); }
+
+        void set(int x, int y, int slot, Entities::EntityType type)
+        {
+            Chunk& c = *chunks[(x >> shift) * chunkCols + (y >> shift)];
+            c.slots[local(x, y)] = slot;
+            c.types[local(x, y)] = type;
+        }
+
+        Entities::EntityType typeAt(int x, int y) const { return chunkOf(x, y)->types[local(x, y)]; }
+
+        /// Sum of the slots of occupied tiles in the wrapped square window, walked like
+        /// Board::forEachInWindow: row by row, in runs that stay inside one chunk.
+        long window(int cx, int cy, int radius) const
+        {
+            long sum = 0;
+            const int n = 2 * radius + 1;
+            const int firstCol = (cy - radius + side) % side;
+
+            for (int i = 0; i < n; ++i)
+            {
+                const int x = (cx - radius + i + side) % side;
+                int y = firstCol;
+                int remaining = n;
+                while (remaining > 0)
+                {
+                    const int run = std::min(remaining, size - (y & (size - 1)));
+                    const Chunk* c = chunkOf(x, y);
+                    for (int k = y; k < y + run; ++k)
+                    {
+                        const int tile = local(x, k);
+                        if (c->types[tile] != Entities::EntityType::NONE) sum += c->slots[tile];
+                    }
+                    remaining -= run;
+                    y = (y + run) % side;
+                }
+            }
+            return sum;
+        }
+
+        int neighbours(int x, int y) const
+        {
+            return static_cast<int>(typeAt((x + 1) % side, y)) + static_cast<int>(typeAt((x + side - 1) % side, y))
+                 + static_cast<int>(typeAt(x, (y + 1) % side)) + static_cast<int>(typeAt(x, (y + side - 1) % side));
+        }
+
+    private:
+        int side;
+        int chunkCols;
+        std::vector<std::unique_ptr<Chunk>> chunks;
+    };
+
+    template <Layout L>
+    void run(const char* name, int side, double density)
+    {
+        TileGrid<L> grid(side);
+        std::mt19937 rng(11);
+        const int count = static_cast<int>(density * side * side);
+        for (int i = 0; i < count; ++i)
+            grid.set(rng() % side, rng() % side, i, Entities::EntityType::ENEMY);
+
+        const int queries = 1 << 18;
+        std::vector<Utils::Position> random(queries), walk(queries);
+        for (auto& p : random) p = {static_cast<int>(rng() % side), static_cast<int>(rng() % side)};
+
+        // Many entities each scanning around itself, stepping one tile per tick.
+        Utils::Position w{0, 0};
+        for (int i = 0; i < queries; ++i)
+        {
+            if (i % 64 == 0) w = random[i];
+            w = (rng() & 1) ? Utils::Position{(w.x + 1) % side, w.y} : Utils::Position{w.x, (w.y + 1) % side};
+            walk[i] = w;
+        }
+
+        long sink = 0;
+        size_t i = 0;
+        auto at = [&](const std::vector<Utils::Position>& ps) -> const Utils::Position& { return ps[i++ % ps.size()]; };
+
+        double near5 = Bench::timePerCall(queries, [&] { auto& p = at(random); sink += grid.window(p.x, p.y, 2); });
+        double fov17 = Bench::timePerCall(queries, [&] { auto& p = at(random); sink += grid.window(p.x, p.y, 8); });
+        double nb = Bench::timePerCall(queries, [&] { auto& p = at(random); sink += grid.neighbours(p.x, p.y); });
+        double walk5 = Bench::timePerCall(queries, [&] { auto& p = at(walk); sink += grid.window(p.x, p.y, 2); });
+        double walkNb = Bench::timePerCall(queries, [&] { auto& p = at(walk); sink += grid.neighbours(p.x, p.y); });
+
+        std::cout << name << "\t" << side << "\t" << near5 << "\t" << fov17 << "\t" << nb
+                  << "\t" << walk5 << "\t" << walkNb << (sink == 42 ? " " : "") << "\n";
+    }
+}
+
+void Bench::tileLayout()
+{
+    std::cout << "layout\tside\tns/5x5\tns/17x17\tns/neighbours\tns/5x5 walk\tns/neighbours walk\n";
+
+    for (int side : {256, 1024, 4096})
+    {
+        run<Layout::ROW_MAJOR>("row-major", side, 0.02);
+        run<Layout::MORTON>("z-bits", side, 0.02);
+        run<Layout::MORTON_TABLE>("z-table", side, 0.02);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "bench.h"
+#include "utils/grid.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// One random walk step per call: move, then the row-major index and the distance to the
+    /// board centre of the new tile, as the enemy tick does.
+    template <typename Grid>
+    double walk(const Grid& grid, const std::vector<Utils::Direction>& dirs, long& sink)
+    {
+        Utils::Position pos{0, 0};
+        const Utils::Position centre{grid.height() / 2, grid.width() / 2};
+        size_t i = 0;
+
+        return Bench::timePerCall(static_cast<int>(dirs.size()), [&] {
+            pos = grid.step(pos, dirs[i++]);
+            sink += grid.index(pos) + grid.distanceSquared(pos, centre);
+        });
+    }
+
+    template <Core::Topology Topo>
+    void run(const char* name, int side, const std::vector<Utils::Direction>& dirs)
+    {
+        Core::Size size;
+        size.width = size.height = side;
+        size.topology = Topo;
+
+        long sink = 0;
+        double dynamic = walk(Utils::Grid<Topo>(size), dirs, sink);
+        double dispatched = Utils::withGrid(size, [&](const auto& grid) { return walk(grid, dirs, sink); });
+
+        std::cout << name << "\t" << side << "\t" << dynamic << "\t" << dispatched << (sink == 42 ? " " : "") << "\n";
+    }
+}
+
+void Bench::topology()
+{
+    std::mt19937 rng(5);
+    std::vector<Utils::Direction> dirs(1 << 22);
+    for (auto& d : dirs) d = static_cast<Utils::Direction>(rng() % 4);
+
+    std::cout << "topology\tside\tns/step run-time size\tns/step dispatched\n";
+
+    // 19 and the powers of two have specialised grids, 1000 falls back to the run-time one.
+    for (int side : {19, 256, 1000, 4096})
+    {
+        run<Core::Topology::WRAP>("wrap", side, dirs);
+        run<Core::Topology::BOUNDED>("bounded", side, dirs);
+    }
+}
\ No newline at end of file
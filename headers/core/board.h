@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <string>
 #include <vector>
 #include <sstream>
@@ -8,7 +9,17 @@
 #include <iostream>
 #include <unordered_map>
 #include <memory>
+#include <span>
+#include "config.h"
+#include "chunkStore.h"
+#include "spatialHash.h"
+#include "tileLayer.h"
+#include "boardJournal.h"
+#include "boardSnapshot.h"
+#include "entityRegistry.h"
+#include "memoryTracker.h"
 #include "utils/position.h"
+#include "utils/direction.h"
 #include "entities/entity.h"
 #include "entities/enemy.h"
 
@@ -16,31 +27,266 @@ namespace Entities { class Enemy; }
 
 namespace Core 
 {
-    struct Size
+    /// Rectangle of tiles, wrapping around the board edges.
+    struct TileArea
     {
-        short boardSize = 19;
-        short tileSize = 32;
+        Utils::Position origin;
+        int height;
+        int width;
     };
 
+    struct Move
+    {
+        Utils::Position from;
+        Utils::Position to;
+    };
+
+    enum class MoveResult : std::uint8_t
+    {
+        MOVED,
+        /// No entity on the source tile.
+        NO_ENTITY,
+        /// The target holds an entity that stays there or a wall, or is outside the resident chunks.
+        OCCUPIED,
+        /// Another move of the batch won the same target (or source) tile.
+        CONFLICT,
+        /// Source or target outside the board.
+        INVALID
+    };
+
+    /// Each tile holds one entity per TileLayer (an actor standing on an item) over its Terrain.
+    ///
+    /// With the DENSE backend the board is split in chunkSize x chunkSize chunks. Chunks are
+    /// created when an entity is first placed in them, and chunks far from the residency center
+    /// are saved to disk and freed (see updateResidency), so only entities near the player are
+    /// in memory. The SPARSE backend keeps every occupied tile in a SpatialHash per layer instead,
+    /// which suits big, mostly empty boards; it does not stream to disk.
     class Board
     {
     public:
 
-        void setEntityAt(Utils::Position pos, std::shared_ptr<Entities::IEntity> e);
-        void deleteEntityAt(Utils::Position pos);
+        static constexpr int typeCount = static_cast<int>(Entities::EntityType::NONE);
+        static constexpr int chunkShift = 5;
+        static constexpr int chunkSize = 1 << chunkShift;
+
+        /// Entities placed on the board must belong to registry, which must outlive the board.
+        explicit Board(EntityRegistry& registry, Size size = {}, StreamingConfig streaming = {}, BoardBackend backend = BoardBackend::DENSE);
+
+        /// Places the entity on pos, or moves it there when it is already on the board.
+        /// An entity previously on the same layer of pos is destroyed, the other layer is kept.
+        void setEntityAt(Utils::Position pos, EntityId id);
+        /// Removes the entity on layer of pos from the board and destroys it.
+        void deleteEntityAt(Utils::Position pos, TileLayer layer);
+        /// Removes the entity on layer of pos from the board and hands it to the caller (still alive).
+        EntityId takeEntityAt(Utils::Position pos, TileLayer layer);
+
+        /// Moves the actor at from to to, which must have no actor and no wall and be resident:
+        /// moves never load a chunk from disk. Items under either tile stay where they are.
+        /// Never deletes anything.
+        MoveResult moveEntity(Utils::Position from, Utils::Position to);
+        /// Applies a batch of actor moves in one pass, results[i] tells what happened to moves[i].
+        /// A move may target a tile its occupant leaves in the same batch (chains and rotations).
+        /// When several moves target the same tile, the one coming from the smallest (x, y)
+        /// wins, so the outcome does not depend on the order of moves.
+        void applyMoves(std::span<const Move> moves, std::span<MoveResult> results);
+
+        /// Null handle when layer of the tile is empty.
+        EntityId getEntityAt(Utils::Position pos, TileLayer layer) const;
+        Entities::EntityType getEntityTypeAt(Utils::Position pos, TileLayer layer) const;
+        /// No entity on any layer and no wall.
+        bool isTileEmpty(Utils::Position pos) const;
+
+        /// Terrain of chunks that are on disk or were never loaded reads as FLOOR.
+        Terrain getTerrainAt(Utils::Position pos) const;
+        /// With DENSE, loads (or creates) the chunk of pos. An actor standing there stays.
+        void setTerrainAt(Utils::Position pos, Terrain terrain);
+
+        /// Enemies and walls block movement. Tiles of chunks that are on disk are never walkable.
+        bool isTileWalkable(Utils::Position pos) const { return !isTileBlocked(pos); }
+
+        /// Bit (1 << Utils::Direction) is set when the neighbour in that direction is walkable.
+        std::uint8_t getWalkableNeighbours(Utils::Position pos) const;
+        /// Batch version, masks[i] is the mask of positions[i].
+        void getWalkableNeighbours(std::span<const Utils::Position> positions, std::span<std::uint8_t> masks) const;
+
+        /// Views on the loaded entities, valid until the next insertion or removal.
+        /// Entities are kept grouped by type, so each type is one contiguous range.
+        std::span<const EntityId> getEntities() const { return entities; }
+        std::span<const EntityId> getEntitiesOfType(Entities::EntityType type) const;
+
+        /// Entities of the types in typeMask at most radius tiles away on each axis, wrapping
+        /// around the board edges. Writes up to out.size() entities and returns how many were written.
+        size_t queryRadius(Utils::Position center, int radius, Entities::EntityTypeMask typeMask,
+                           std::span<EntityId> out) const;
+        /// Same search, keeping the out.size() nearest entities (squared distance), nearest first.
+        size_t queryNearest(Utils::Position center, int radius, Entities::EntityTypeMask typeMask,
+                            std::span<EntityId> out) const;
+        /// Squared distance between two tiles, going around the board edges when shorter.
+        int distanceSquared(Utils::Position a, Utils::Position b) const;
+
+        /// Loaded entities of type.
+        size_t countOf(Entities::EntityType type) const;
+        size_t enemyCount() const { return countOf(Entities::EntityType::ENEMY); }
+        size_t healCount() const { return countOf(Entities::EntityType::HEAL); }
+        /// Entities of type on the board, those of chunks on disk included.
+        size_t totalCountOf(Entities::EntityType type) const;
 
-        std::shared_ptr<Entities::IEntity> getEntityAt(Utils::Position pos) const;
-        Entities::EntityType getEntityTypeAt(Utils::Position pos) const;
+        /// Loads the chunks around center and evicts the others. Until the first call every chunk stays in memory.
+        /// The window goes around the board edges on a WRAP board and stops at them on a BOUNDED one.
+        void updateResidency(Utils::Position center);
+        bool isTileResident(Utils::Position pos) const;
+        /// Smallest tile area covering the resident chunks (the whole board before updateResidency).
+        TileArea getResidentArea() const;
+        size_t getLoadedChunkCount() const { return loadedChunks; }
 
-        bool isTileWalkable(Utils::Position pos) const;
+        /// Immutable copy of the loaded entities for other threads. Only chunks changed since the
+        /// previous snapshot are copied again, the others are shared.
+        std::shared_ptr<const BoardSnapshot> snapshot();
+        /// Marks the entity at pos as changed (stats), so the next snapshot copies it again.
+        void touch(Utils::Position pos);
 
-        std::vector<std::shared_ptr<Entities::Enemy>> getEnemies() const;
-        std::vector<std::shared_ptr<Entities::IEntity>> getEntities() const;
+        /// Spawns, despawns and moves of the current tick.
+        BoardJournal& getJournal() { return journal; }
+        const BoardJournal& getJournal() const { return journal; }
 
+        EntityRegistry& getRegistry() const { return registry; }
         Size getBoardSizes() const { return boardSize; }
+        BoardBackend getBackend() const { return backend; }
+        /// Bytes used by the tile storage (chunks or hash table), entity objects excluded.
+        size_t getTileMemoryBytes() const;
 
     private:
+        enum class ChunkState : std::uint8_t
+        {
+            /// Never used or empty when evicted, nothing to load.
+            EMPTY,
+            LOADED,
+            ON_DISK
+        };
+
+        struct Chunk
+        {
+            /// Per-layer, per-tile slot in entities (-1 when empty) and entity type.
+            int slots[layerCount][chunkSize * chunkSize];
+            Entities::EntityType types[layerCount][chunkSize * chunkSize];
+            Terrain terrain[chunkSize * chunkSize];
+            /// One word per row, bit y set when the tile holds an entity of the layer.
+            std::uint32_t occupiedRows[layerCount][chunkSize] = {};
+            /// Same for walls, and for tiles blocking movement (walls and enemies).
+            std::uint32_t wallRows[chunkSize] = {};
+            std::uint32_t blockedRows[chunkSize] = {};
+            int typeCounts[typeCount] = {};
+            int entityCount = 0;
+            int wallCount = 0;
+
+            bool hasAny(Entities::EntityTypeMask typeMask) const;
+
+            Chunk();
+
+            /// Counted against the board, chunks are its biggest allocation.
+            static void* operator new(size_t bytes)
+            {
+                memory().onAllocate(MemoryTag::BOARD, bytes);
+                return ::operator new(bytes);
+            }
+            static void operator delete(void* p, size_t bytes)
+            {
+                memory().onFree(MemoryTag::BOARD, bytes);
+                ::operator delete(p);
+            }
+        };
+
+        struct TileInfo
+        {
+            int slot;
+            Entities::EntityType type;
+        };
+
+        bool isInside(Utils::Position pos) const { return pos.x >= 0 && pos.y >= 0 && pos.x < boardSize.height && pos.y < boardSize.width; }
+        /// Slot and type of a tile layer, {-1, NONE} when empty. Backend independent.
+        TileInfo readTile(Utils::Position pos, TileLayer layer) const;
+        /// Sets a tile layer (type NONE clears it). With DENSE the chunk must be loaded.
+        void writeTile(Utils::Position pos, TileLayer layer, int slot, Entities::EntityType type);
+
+        /// Chunk index of pos, -1 if pos is outside the board.
+        int chunkIndex(Utils::Position pos) const;
+        /// Row-major inside the chunk: a row of types is half a cache line, so small windows already
+        /// touch few lines, and Z-order measured no faster (bench tileLayout).
+        static int localIndex(Utils::Position pos) { return ((pos.x & (chunkSize - 1)) << chunkShift) | (pos.y & (chunkSize - 1)); }
+        static bool blocksMovement(Entities::EntityType type) { return type == Entities::EntityType::ENEMY; }
+        static void setTile(Chunk& chunk, Utils::Position pos, TileLayer layer, int slot, Entities::EntityType type);
+        static void setTerrain(Chunk& chunk, Utils::Position pos, Terrain terrain);
+        /// Recomputes the blocked bit of a tile from its actor and terrain.
+        static void updateBlocked(Chunk& chunk, Utils::Position pos);
+        /// Type of the entity in slot.
+        Entities::EntityType typeOfSlot(int slot) const { return registry.getComponents().types[entities[slot].index()]; }
+
+        bool isTileBlocked(Utils::Position pos) const;
+        /// getWalkableNeighbours for a board with the neighbour math of Grid.
+        template <typename Grid>
+        std::uint8_t walkableMask(const Grid& grid, Utils::Position pos) const;
+        static std::uint32_t tileKey(Utils::Position pos) { return SpatialHash::keyOf(pos); }
+        /// Takes the entry on layer of pos off the board (slot, tile and journal). Null handle when empty.
+        EntityId detach(Utils::Position pos, TileLayer layer);
+        /// Moves the entry of slot from its tile to the empty tile to.
+        void relocate(int slot, Utils::Position to);
+
+        Chunk* materialize(int chunk);
+        void evict(int chunk);
+        std::shared_ptr<const ChunkSnapshot> buildChunkSnapshot(int chunk) const;
+        bool isChunkResident(int chunk) const;
+        int insertSlot(Entities::EntityType type);
+        void removeSlot(int slot);
+        /// Moves the entry at from into the (free) slot to and updates its tile.
+        void moveSlot(int from, int to);
+        /// Calls visit(slot) for each tile of the wrapped square window matching typeMask.
+        template <typename Visit>
+        void forEachInWindow(Utils::Position center, int radius, Entities::EntityTypeMask typeMask, Visit&& visit) const;
+
+        EntityRegistry& registry;
         Size boardSize;
-        std::vector<std::shared_ptr<Entities::IEntity>> entities;
+        BoardBackend backend;
+        int chunkRows;
+        int chunkCols;
+
+        /// Loaded entities, grouped by type: type t occupies [typeBegin[t], typeBegin[t + 1]).
+        TrackedVector<EntityId, MemoryTag::BOARD> entities;
+        /// Position of each entry in entities (same order), packed so the sparse window scan
+        /// reads half the bytes.
+        TrackedVector<Utils::PackedPosition, MemoryTag::BOARD> entityPositions;
+        int typeBegin[typeCount + 1] = {};
+
+        SpatialHash sparseTiles[layerCount];
+        /// Walls of the SPARSE backend, the Terrain value stored as the slot.
+        SpatialHash sparseTerrain;
+
+        TrackedVector<std::unique_ptr<Chunk>, MemoryTag::BOARD> chunks;
+        TrackedVector<ChunkState, MemoryTag::BOARD> chunkStates;
+        size_t loadedChunks = 0;
+
+        int residentRadius;
+        bool hasResidencyCenter = false;
+        Utils::Position residencyCenter{0, 0};
+        /// Entities of each type saved with each ON_DISK chunk, and their sum over the chunks.
+        TrackedVector<std::array<int, typeCount>, MemoryTag::BOARD> storedCounts;
+        std::array<size_t, typeCount> storedTotals{};
+        /// DENSE only, the SPARSE backend never streams.
+        std::unique_ptr<ChunkStore> store;
+        BoardJournal journal;
+
+        /// Last snapshot of each chunk (nullptr when it had no entity) and chunks changed since.
+        TrackedVector<std::shared_ptr<const ChunkSnapshot>, MemoryTag::BOARD> snapshotCache;
+        TrackedVector<std::uint8_t, MemoryTag::BOARD> snapshotDirty;
+        TrackedVector<int, MemoryTag::BOARD> dirtyChunks;
+
+        /// Working buffers of applyMoves, kept between calls so batches do not allocate.
+        struct MoveScratch
+        {
+            TrackedVector<int, MemoryTag::BOARD> order;
+            TrackedVector<int, MemoryTag::BOARD> slots;
+            TrackedVector<int, MemoryTag::BOARD> dependsOn;
+            TrackedVector<std::uint8_t, MemoryTag::BOARD> states;
+            TrackedVector<int, MemoryTag::BOARD> stack;
+        } moveScratch;
     };
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "entityId.h"
+#include "memoryTracker.h"
+#include "entities/entity.h"
+#include "utils/position.h"
+
+namespace Core {
+
+    struct BoardChange
+    {
+        enum class Kind : std::uint8_t
+        {
+            SPAWN,
+            DESPAWN,
+            MOVE,
+            /// Terrain of a tile set, type NONE and no entity.
+            TERRAIN
+        };
+
+        Kind kind;
+        Entities::EntityType type;
+        /// SPAWN, TERRAIN: same as to.
+        Utils::Position from;
+        /// DESPAWN: same as from.
+        Utils::Position to;
+        /// Stale once a despawned entity is destroyed.
+        EntityId entity;
+    };
+
+    /// Changes made to the board during the current tick, so consumers can update
+    /// incrementally instead of rescanning the board. Chunks streamed out or in
+    /// show up as DESPAWN / SPAWN of their entities and TERRAIN of their walls.
+    class BoardJournal
+    {
+    public:
+
+        /// Disabled journals record nothing (boards nobody consumes changes from).
+        void setEnabled(bool e) { enabled = e; if (!e) changes.clear(); }
+        bool isEnabled() const { return enabled; }
+
+        void record(const BoardChange& change) { if (enabled) changes.push_back(change); }
+
+        /// Every change since the tick started, oldest first.
+        std::span<const BoardChange> getChanges() const { return changes; }
+        std::uint32_t getTick() const { return tick; }
+
+        /// Hands the pending changes to consume, oldest first, then forgets them.
+        template <typename Fn>
+        void drain(Fn&& consume)
+        {
+            for (const auto& change : changes)
+                consume(change);
+            changes.clear();
+        }
+
+        /// Called once per frame by the game. Keeps the buffer capacity, so steady-state ticks do not allocate.
+        void nextTick()
+        {
+            changes.clear();
+            ++tick;
+        }
+
+    private:
+        TrackedVector<BoardChange, MemoryTag::BOARD> changes;
+        std::uint32_t tick = 0;
+        bool enabled = false;
+    };
+}
\ No newline at end of file
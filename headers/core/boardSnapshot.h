@@ -0,0 +1,69 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "config.h"
+#include "entityId.h"
+#include "memoryTracker.h"
+#include "tileLayer.h"
+#include "entities/entity.h"
+#include "entities/stats.h"
+#include "utils/position.h"
+
+namespace Core {
+
+    /// Copy of one entity's state at snapshot time.
+    struct EntitySnapshot
+    {
+        /// Resolve it through the registry on the game thread only.
+        EntityId entity;
+        Entities::EntityType type;
+        Utils::Position pos;
+        /// Interned name, its storage never moves so readers on other threads can keep the view.
+        std::string_view name;
+        /// Player and enemies only, default stats for items.
+        Entities::Stats stats{0, 0, 0};
+    };
+
+    /// Entities of one chunk. Immutable once built and shared by every snapshot taken
+    /// while the chunk did not change.
+    struct ChunkSnapshot
+    {
+        TrackedVector<EntitySnapshot, MemoryTag::BOARD> entities;
+    };
+
+    /// Immutable view of the loaded board at one tick, safe to read from any thread.
+    /// Unchanged chunks are shared with the previous snapshots instead of copied.
+    class BoardSnapshot
+    {
+    public:
+
+        Size getBoardSizes() const { return boardSize; }
+        std::uint32_t getTick() const { return tick; }
+        size_t getChunkCount() const { return chunks.size(); }
+
+        size_t entityCount() const;
+        /// nullptr when layer of the tile was empty.
+        const EntitySnapshot* findAt(Utils::Position pos, TileLayer layer) const;
+
+        template <typename Fn>
+        void forEachEntity(Fn&& fn) const
+        {
+            for (const auto& [index, chunk] : chunks)
+                for (const auto& e : chunk->entities)
+                    fn(e);
+        }
+
+    private:
+        friend class Board;
+
+        Size boardSize;
+        int chunkShift = 5;
+        int chunkCols = 0;
+        std::uint32_t tick = 0;
+        /// Non-empty chunks sorted by chunk index.
+        TrackedVector<std::pair<int, std::shared_ptr<const ChunkSnapshot>>, MemoryTag::BOARD> chunks;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <span>
+#include "entityRegistry.h"
+#include "tileLayer.h"
+#include "entities/entity.h"
+
+namespace Core {
+
+    /// Disk storage for evicted board chunks, one file per chunk in a directory of its own.
+    class ChunkStore
+    {
+    public:
+
+        /// Creates a new directory under root (the system temp directory when empty), so two
+        /// stores never share or clear each other's files. It is removed with the store.
+        explicit ChunkStore(const std::string& root = {});
+        ~ChunkStore();
+
+        ChunkStore(const ChunkStore&) = delete;
+        ChunkStore& operator=(const ChunkStore&) = delete;
+
+        /// terrain holds every tile of the chunk in row-major order, or is empty when the chunk is all floor.
+        bool save(int chunk, const std::vector<Entities::IEntity*>& entities, std::span<const Terrain> terrain = {});
+        /// Reads the chunk back into new entities of registry and deletes its file.
+        /// Positions are restored on the entities, the caller places them on the board.
+        /// Saved terrain is copied to terrain, left untouched when the chunk was all floor.
+        std::vector<EntityId> load(int chunk, EntityRegistry& registry, std::span<Terrain> terrain = {});
+
+    private:
+        std::string pathOf(int chunk) const;
+
+        /// Empty when it could not be created, saves then fail and chunks stay in memory.
+        std::string directory;
+    };
+}
\ No newline at end of file
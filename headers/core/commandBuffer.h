@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+#include "entityId.h"
+#include "utils/position.h"
+
+namespace Core {
+
+    class Board;
+
+    /// Structural changes recorded during a tick and applied together at the tick boundary,
+    /// so no entity is freed while systems still iterate or hold pointers to it.
+    class CommandBuffer
+    {
+    public:
+
+        /// Places an entity already created in the registry at the next apply. Another tile
+        /// is picked if the target got taken in the meantime, the entity is destroyed when
+        /// there is none left.
+        void spawn(EntityId entity, Utils::Position pos);
+        /// Removes the entity from the board (when it is still there) and destroys it at the next apply.
+        void despawn(EntityId entity);
+
+        /// Runs every despawn then every spawn, and empties the buffer.
+        void apply(Board& board);
+
+        bool empty() const { return spawns.empty() && despawns.empty(); }
+
+    private:
+        struct Spawn
+        {
+            EntityId entity;
+            Utils::Position pos;
+        };
+
+        std::vector<Spawn> spawns;
+        std::vector<EntityId> despawns;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "memoryTracker.h"
+#include "entities/entityType.h"
+#include "entities/stats.h"
+#include "utils/position.h"
+
+namespace Core {
+
+    /// Hot per-entity data as parallel arrays indexed by EntityId::index(), so loops over every
+    /// entity read a few contiguous arrays instead of one heap object each.
+    /// Rows of free indices have type NONE.
+    struct ComponentStore
+    {
+        TrackedVector<Entities::EntityType, MemoryTag::ENTITIES> types;
+        TrackedVector<Utils::Position, MemoryTag::ENTITIES> positions;
+        /// Player and enemies only, unused for items.
+        TrackedVector<Entities::Stats, MemoryTag::ENTITIES> stats;
+        /// Effective values computed from stats and equipment, refreshed when either changes.
+        TrackedVector<Entities::DerivedStats, MemoryTag::ENTITIES> derived;
+        /// SDL tick after which the entity acts again.
+        TrackedVector<std::uint32_t, MemoryTag::ENTITIES> nextActionTimes;
+
+        /// Bytes one row adds to the store.
+        static constexpr size_t rowBytes = sizeof(Entities::EntityType) + sizeof(Utils::Position) +
+            sizeof(Entities::Stats) + sizeof(Entities::DerivedStats) + sizeof(std::uint32_t);
+
+        size_t size() const { return types.size(); }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace Core {
+
+    /// What lies past the board edge: the opposite edge (a torus), or nothing.
+    enum class Topology
+    {
+        WRAP,
+        BOUNDED
+    };
+
+    /// Board dimensions. Position::x is the row (0..height-1), Position::y the column (0..width-1).
+    struct Size
+    {
+        int width = 19;
+        int height = 19;
+        short tileSize = 32;
+        Topology topology = Topology::WRAP;
+    };
+
+    /// Tile storage of the board: a chunked grid, or a hash of occupied tiles for sparse worlds.
+    enum class BoardBackend
+    {
+        DENSE,
+        SPARSE
+    };
+
+    /// Which board chunks stay in memory. Chunks further than residentRadius (in chunks)
+    /// from the player are written to disk and freed.
+    struct StreamingConfig
+    {
+        int residentRadius = 2;
+        /// Where each board makes its own chunk directory, the system temp directory when empty.
+        std::string chunkDirectory;
+    };
+
+    /// Optional hard memory caps in bytes, 0 for no cap. With hardCaps set, spawns are skipped
+    /// once entity memory would go over entityBytes and the text cache of the view starts
+    /// over instead of growing past textBytes.
+    struct MemoryConfig
+    {
+        bool hardCaps = false;
+        size_t entityBytes = 0;
+        size_t textBytes = 0;
+    };
+
+    struct GameConfig
+    {
+        static constexpr int minBoardSize = 5;
+        static constexpr int maxBoardSize = 4096;
+
+        Size board;
+        BoardBackend boardBackend = BoardBackend::DENSE;
+        StreamingConfig streaming;
+        MemoryConfig memory;
+        /// Tiles shown on each axis. Boards bigger than this scroll with the player.
+        int viewTiles = 19;
+        /// Width in pixels of the info panel drawn right of the board.
+        int infoPanelWidth = 292;
+        /// Threads deciding the enemy moves, 0 for one per hardware thread. Any count plays the same.
+        int enemyThreads = 1;
+
+        int boardPixelSize() const { return viewTiles * board.tileSize; }
+        int windowWidth() const { return boardPixelSize() + infoPanelWidth; }
+        int windowHeight() const { return boardPixelSize(); }
+
+        /// Reads "GameRpg [width] [height] [dense|sparse] [entityCapKiB] [wrap|bounded] [enemyThreads]", clamping
+        /// sizes to [minBoardSize, maxBoardSize]. An entity cap above 0 turns hard memory caps on.
+        static GameConfig fromArgs(int argc, char* argv[]);
+    };
+}
\ No newline at end of file
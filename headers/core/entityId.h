@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+
+namespace Core {
+
+    /// Handle on an entity of the EntityRegistry: 20 bits of index and 12 bits of generation.
+    /// The generation changes each time an index is reused, so a handle kept after its entity
+    /// was destroyed resolves to nothing instead of to the next entity. Value 0 is the null handle.
+    struct EntityId
+    {
+        static constexpr int indexBits = 20;
+        static constexpr std::uint32_t indexMask = (1u << indexBits) - 1;
+        static constexpr std::uint32_t generationMask = (1u << (32 - indexBits)) - 1;
+
+        std::uint32_t value = 0;
+
+        static constexpr EntityId make(std::uint32_t index, std::uint32_t generation)
+        {
+            return EntityId{(generation << indexBits) | (index & indexMask)};
+        }
+
+        constexpr std::uint32_t index() const { return value & indexMask; }
+        constexpr std::uint32_t generation() const { return value >> indexBits; }
+
+        constexpr explicit operator bool() const { return value != 0; }
+        constexpr bool operator==(const EntityId& other) const { return value == other.value; }
+        constexpr bool operator!=(const EntityId& other) const { return value != other.value; }
+    };
+}
\ No newline at end of file
@@ -1,8 +1,14 @@
 #pragma once
 #include <iostream>
 #include "core/board.h"
+#include "core/commandBuffer.h"
+#include "core/memoryTracker.h"
+#include "core/workerPool.h"
 #include "entities/player.h"
 #include "entities/healItem.h"
+#include "entities/moveIntent.h"
+#include "systems/flowField.h"
+#include "systems/pathFinder.h"
 #include "utils/util.h"
 
 namespace Entities { class Player; }
@@ -11,17 +17,63 @@ namespace Core {
 
     struct Game;
     class Board;
+    struct Move;
+    enum class MoveResult : std::uint8_t;
 
     struct EntityManager
     {
     private:
-        int playerBasedHp(std::shared_ptr<Entities::Player> player);
-        double playerBasedAttack(std::shared_ptr<Entities::Player> player);
-        double playerBasedDefense(std::shared_ptr<Entities::Player> player);
-        double playerBasedHealAmmount(std::shared_ptr<Entities::Player> player);
+        int playerBasedHp(const Entities::Stats& playerStats);
+        Entities::Fixed playerBasedAttack(const Entities::Stats& playerStats);
+        Entities::Fixed playerBasedDefense(const Entities::Stats& playerStats);
+        Entities::Fixed playerBasedHealAmmount(const Entities::Stats& playerStats);
+        /// false (logged once per capped stretch) when count more T would go over the entity memory cap.
+        template <typename T>
+        bool canSpawn(int count);
+
+        /// Enemies due to act this tick, by component store index, and whether they chase.
+        struct DueEnemy
+        {
+            std::uint32_t index;
+            bool chasing;
+        };
+
+        /// Applies the intents of the due enemies: each round moves every enemy with a step
+        /// left through one Board::applyMoves, which settles conflicts on tiles alone. A step
+        /// onto the player starts a fight, the first due enemy (earliest round) getting it.
+        void resolveIntents(Core::Game& g);
+
+        bool spawnCapped = false;
+
+        /// Scratch of enemyAlgorithm, kept between ticks. intents[k] belongs to dueEnemies[k].
+        TrackedVector<DueEnemy, MemoryTag::AI> dueEnemies;
+        TrackedVector<Entities::MoveIntent, MemoryTag::AI> intents;
+        TrackedVector<Move, MemoryTag::AI> moves;
+        TrackedVector<MoveResult, MemoryTag::AI> moveResults;
+        /// Index in dueEnemies of the enemy making moves[i].
+        TrackedVector<std::uint32_t, MemoryTag::AI> movers;
+        /// Seeds the patrol rolls, so they depend on the tick and the enemy, not on threads.
+        std::uint64_t enemyTicks = 0;
     public:
-        void spawnEnemy(Core::Board& board,std::shared_ptr<Entities::Player> player);
-        void spawnHeal(Core::Board& board,std::shared_ptr<Entities::Player> player);
+        /// threads <= 0 decides enemy moves on one thread per hardware thread.
+        explicit EntityManager(int threads = 1);
+
+        /// Milliseconds between two moves of an enemy.
+        const Uint32 enemyMoveDelay = 200;
+        /// Decides the moves of the due enemies, each thread on a slice of them.
+        WorkerPool workers;
+        /// One per worker, a chasing enemy searches with the one of its thread.
+        std::vector<Systems::PathFinder> pathFinders;
+        /// Steps towards the player for every chaser, moved with the player each enemy update
+        /// and repaired from the board journal each frame.
+        Systems::FlowField flowField{24};
+
+        /// Spawns are queued on the command buffer and placed at its next apply.
+        void spawnEnemy(Core::Board& board, CommandBuffer& commands, EntityId player);
+        void spawnHeal(Core::Board& board, CommandBuffer& commands, EntityId player);
+        /// Two phases: every due enemy decides its intent on the worker threads, reading the
+        /// board only, then resolveIntents applies them on this thread. The result does not
+        /// depend on the number of threads.
         void enemyAlgorithm(Core::Game& g);
         void initEntities(Core::Game& g);
     };
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "componentStore.h"
+#include "entityId.h"
+#include "memoryTracker.h"
+#include "slabPool.h"
+#include "entities/entity.h"
+
+namespace Core {
+
+    /// Owns every entity of the game and resolves EntityId handles to them.
+    /// Destroyed entities leave their index to the next created one with a new generation.
+    /// Hot data (type, position, stats, action timer) is kept in a ComponentStore row per index.
+    /// Entity objects come from one SlabPool per concrete type.
+    class EntityRegistry
+    {
+    public:
+
+        EntityRegistry() = default;
+        EntityRegistry(const EntityRegistry&) = delete;
+        EntityRegistry& operator=(const EntityRegistry&) = delete;
+        ~EntityRegistry();
+
+        template <typename T, typename... Args>
+        EntityId create(Args&&... args)
+        {
+            SlabPool<T>& pool = poolOf<T>();
+            return add(pool.acquire(std::forward<Args>(args)...), pool);
+        }
+        void destroy(EntityId id);
+
+        bool isAlive(EntityId id) const;
+        /// nullptr for the null handle and for stale handles.
+        Entities::IEntity* get(EntityId id) const;
+        /// Same, also nullptr when the entity is not a T. Checks the type byte, no RTTI.
+        template <typename T>
+        T* get(EntityId id) const
+        {
+            Entities::IEntity* e = get(id);
+            if (!e || !(Entities::EntityKind<T>::mask & Entities::typeMaskOf(components.types[id.index()])))
+                return nullptr;
+            return static_cast<T*>(e);
+        }
+
+        /// Handle of the live entity at index, for loops over the component store.
+        EntityId idAt(std::uint32_t index) const { return EntityId::make(index, generations[index]); }
+
+        ComponentStore& getComponents() { return components; }
+        const ComponentStore& getComponents() const { return components; }
+
+        /// Live, peak and reuse counts of the pool of T (all zero before the first T).
+        template <typename T>
+        PoolStats getPoolStats() const
+        {
+            const size_t kind = poolKind<T>();
+            return kind < pools.size() && pools[kind] ? pools[kind]->getStats() : PoolStats{};
+        }
+
+        size_t size() const { return liveCount; }
+
+    private:
+        EntityId add(Entities::IEntity* entity, PoolBase& pool);
+
+        static size_t nextPoolKind();
+        template <typename T>
+        static size_t poolKind()
+        {
+            static const size_t kind = nextPoolKind();
+            return kind;
+        }
+
+        template <typename T>
+        SlabPool<T>& poolOf()
+        {
+            const size_t kind = poolKind<T>();
+            if (kind >= pools.size()) pools.resize(kind + 1);
+            if (!pools[kind]) pools[kind] = std::make_unique<SlabPool<T>>();
+            return static_cast<SlabPool<T>&>(*pools[kind]);
+        }
+
+        ComponentStore components;
+        /// Indexed by poolKind<T>(), created on the first T.
+        std::vector<std::unique_ptr<PoolBase>> pools;
+
+        TrackedVector<Entities::IEntity*, MemoryTag::ENTITIES> objects;
+        /// Pool each live object goes back to.
+        TrackedVector<PoolBase*, MemoryTag::ENTITIES> owners;
+        TrackedVector<std::uint32_t, MemoryTag::ENTITIES> generations;
+        TrackedVector<std::uint32_t, MemoryTag::ENTITIES> freeIndices;
+        size_t liveCount = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "memoryTracker.h"
+
+namespace Core {
+
+    /// Bump-pointer memory for data that only lives during one frame, reset by the game loop.
+    /// A frame that outgrows the block spills into extra blocks, merged into one bigger block
+    /// at the next reset, so once the biggest frame has been seen frames do not allocate.
+    class FrameArena
+    {
+    public:
+
+        explicit FrameArena(size_t capacity = 16 * 1024);
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        void* allocate(size_t bytes, size_t align);
+        /// Drops everything allocated since the last reset.
+        void reset();
+
+        /// Bytes handed out this frame.
+        size_t used() const { return offset + spilled; }
+        size_t capacity() const { return block.size(); }
+
+    private:
+        using Block = TrackedVector<std::byte, MemoryTag::FRAME>;
+
+        Block block;
+        size_t offset = 0;
+        /// Blocks of the current frame that did not fit in block.
+        std::vector<Block> overflow;
+        size_t spilled = 0;
+    };
+
+    /// Allocator of FrameArena memory, frees are no-ops until the arena is reset.
+    template <typename T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        ArenaAllocator(FrameArena& _arena) : arena(&_arena) {}
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+        T* allocate(size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T))); }
+        void deallocate(T*, size_t) {}
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+
+    private:
+        template <typename U> friend class ArenaAllocator;
+        FrameArena* arena;
+    };
+
+    using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+    template <typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+    inline void appendText(ArenaString& out, std::string_view text) { out.append(text.data(), text.size()); }
+    inline void appendText(ArenaString& out, int value)
+    {
+        char digits[12];
+        auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+        out.append(digits, end);
+    }
+
+    /// Concatenates text and integers into a string of the frame arena.
+    template <typename... Parts>
+    ArenaString frameText(FrameArena& arena, const Parts&... parts)
+    {
+        ArenaString out{ArenaAllocator<char>(arena)};
+        out.reserve(64);
+        (appendText(out, parts), ...);
+        return out;
+    }
+}
\ No newline at end of file
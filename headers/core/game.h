@@ -2,6 +2,10 @@
 #include <iostream>
 #include <memory>
 #include "board.h"
+#include "commandBuffer.h"
+#include "config.h"
+#include "frameArena.h"
+#include "memoryTracker.h"
 #include "ui/view.h"
 #include "entities/player.h"
 #include "gamestate.h"
@@ -21,9 +25,14 @@ namespace Core {
 
     struct Game
     {
+        GameConfig config;
+        /// Owns every entity, declared before board so it outlives it.
+        EntityRegistry registry;
         std::unique_ptr<Board> board;
-        std::shared_ptr<Entities::Player> player;
-        std::shared_ptr<Entities::Enemy> currentEnemy;
+        /// Spawns and despawns of the current tick, applied between update and render.
+        CommandBuffer commands;
+        EntityId player;
+        EntityId currentEnemy;
         
         Systems::Turn currentTurn = Systems::Turn::PLAYER;
         int selectedIndex = 0;
@@ -37,11 +46,17 @@ namespace Core {
         std::unique_ptr<EntityManager> entityManager;
 
         UI::View view;
+        /// Scratch memory for the current frame (HUD text, ...), reset at the start of each frame.
+        FrameArena frameArena;
 
         GameState state = GameState::TITLE;
         Uint32 lastEnemyUpdate = 0;
         const Uint32 enemyUpdateInterval = 100;
 
+        /// nullptr before initEntities, or once the handle is stale.
+        Entities::Player* getPlayer() const;
+        Entities::Enemy* getCurrentEnemy() const;
+
         void initGame();
         void run();
         void quit();
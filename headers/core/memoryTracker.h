@@ -0,0 +1,110 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace Core {
+
+    /// Subsystems memory is attributed to.
+    enum class MemoryTag : std::uint8_t
+    {
+        BOARD,
+        ENTITIES,
+        TEXTURES,
+        TEXT,
+        INVENTORY,
+        FRAME,
+        /// Search buffers of the enemy AI.
+        AI,
+        COUNT
+    };
+
+    struct MemoryStats
+    {
+        /// Bytes held right now.
+        size_t bytes = 0;
+        size_t peak = 0;
+        /// Allocations made since start, freed or not.
+        size_t allocations = 0;
+        /// 0 when the subsystem has no cap.
+        size_t cap = 0;
+    };
+
+    /// Per-subsystem byte counters, fed by TrackedAllocator and by the owners of memory the
+    /// game does not allocate itself (SDL textures and surfaces).
+    /// Counters are atomic, snapshots may be freed on another thread.
+    class MemoryTracker
+    {
+    public:
+
+        void onAllocate(MemoryTag tag, size_t bytes);
+        void onFree(MemoryTag tag, size_t bytes);
+
+        MemoryStats getStats(MemoryTag tag) const;
+
+        /// Caps are only enforced by the code able to back off (entity spawns, text cache)
+        /// and only while hard caps are enabled. 0 removes the cap.
+        void setCap(MemoryTag tag, size_t bytes);
+        void setHardCaps(bool enabled) { hardCaps = enabled; }
+        bool hardCapsEnabled() const { return hardCaps; }
+        /// true when hard caps are enabled and extra more bytes would go over the cap of tag.
+        bool wouldExceed(MemoryTag tag, size_t extra = 0) const;
+
+        /// One line per subsystem: current, peak, cap and allocation count.
+        void report(std::ostream& out) const;
+
+        static const char* nameOf(MemoryTag tag);
+
+    private:
+        struct Counter
+        {
+            std::atomic<size_t> bytes{0};
+            std::atomic<size_t> peak{0};
+            std::atomic<size_t> allocations{0};
+            std::atomic<size_t> cap{0};
+        };
+
+        std::array<Counter, static_cast<size_t>(MemoryTag::COUNT)> counters;
+        std::atomic<bool> hardCaps{false};
+    };
+
+    /// Tracker shared by the whole game.
+    MemoryTracker& memory();
+
+    /// Standard allocator that counts its blocks against Tag.
+    template <typename T, MemoryTag Tag>
+    class TrackedAllocator
+    {
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind { using other = TrackedAllocator<U, Tag>; };
+
+        TrackedAllocator() = default;
+        template <typename U>
+        TrackedAllocator(const TrackedAllocator<U, Tag>&) {}
+
+        T* allocate(size_t n)
+        {
+            memory().onAllocate(Tag, n * sizeof(T));
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, size_t n)
+        {
+            memory().onFree(Tag, n * sizeof(T));
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        template <typename U>
+        bool operator==(const TrackedAllocator<U, Tag>&) const { return true; }
+    };
+
+    template <typename T, MemoryTag Tag>
+    using TrackedVector = std::vector<T, TrackedAllocator<T, Tag>>;
+}
\ No newline at end of file
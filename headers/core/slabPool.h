@@ -0,0 +1,100 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include "memoryTracker.h"
+
+namespace Core {
+
+    struct PoolStats
+    {
+        size_t live = 0;
+        /// Highest live count so far.
+        size_t peak = 0;
+        /// Acquisitions served from a released slot instead of fresh slab memory.
+        size_t reused = 0;
+        size_t slabs = 0;
+    };
+
+    /// Type-erased side of a pool, so owners can release objects without knowing their type.
+    class PoolBase
+    {
+    public:
+        virtual ~PoolBase() = default;
+        virtual void release(void* object) = 0;
+
+        const PoolStats& getStats() const { return stats; }
+
+    protected:
+        PoolStats stats;
+    };
+
+    /// Objects of one type carved out of fixed-size slabs. Slabs are never moved or freed before
+    /// the pool, so addresses stay stable; released slots go on a free list and are handed out
+    /// again first, so a steady spawn / despawn rate does not touch the allocator.
+    template <typename T, size_t SlabSize = 64>
+    class SlabPool : public PoolBase
+    {
+    public:
+
+        SlabPool() = default;
+        ~SlabPool()
+        {
+            for (Slot* slab : slabs) SlabAllocator().deallocate(slab, SlabSize);
+        }
+        SlabPool(const SlabPool&) = delete;
+        SlabPool& operator=(const SlabPool&) = delete;
+
+        template <typename... Args>
+        T* acquire(Args&&... args)
+        {
+            Slot* slot = freeList;
+
+            if (slot) {
+                freeList = slot->next;
+                ++stats.reused;
+            }
+            else {
+                if (used == SlabSize || slabs.empty()) {
+                    slabs.push_back(SlabAllocator().allocate(SlabSize));
+                    used = 0;
+                    ++stats.slabs;
+                }
+                slot = slabs.back() + used++;
+            }
+
+            T* object = ::new (static_cast<void*>(slot->bytes)) T(std::forward<Args>(args)...);
+
+            if (++stats.live > stats.peak) stats.peak = stats.live;
+            return object;
+        }
+
+        void release(void* object) override
+        {
+            static_cast<T*>(object)->~T();
+
+            Slot* slot = reinterpret_cast<Slot*>(object);
+            slot->next = freeList;
+            freeList = slot;
+            --stats.live;
+        }
+
+    private:
+        union Slot
+        {
+            Slot() {}
+            Slot* next;
+            alignas(T) std::byte bytes[sizeof(T)];
+        };
+
+        using SlabAllocator = TrackedAllocator<Slot, MemoryTag::ENTITIES>;
+
+        /// Raw slot storage, objects are constructed in place by acquire.
+        TrackedVector<Slot*, MemoryTag::ENTITIES> slabs;
+        /// Slots handed out from the last slab.
+        size_t used = 0;
+        Slot* freeList = nullptr;
+    };
+}
\ No newline at end of file
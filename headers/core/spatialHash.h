@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "memoryTracker.h"
+#include "entities/entityType.h"
+#include "utils/position.h"
+
+namespace Core {
+
+    /// Open-addressing hash (linear probing) from a packed tile position to its board slot and type.
+    /// Memory follows the number of occupied tiles instead of the board size.
+    class SpatialHash
+    {
+    public:
+
+        struct Entry
+        {
+            std::uint32_t key = emptyKey;
+            int slot = -1;
+            Entities::EntityType type = Entities::EntityType::NONE;
+        };
+
+        static std::uint32_t keyOf(Utils::Position pos) { return Utils::PackedPosition(pos).bits; }
+
+        SpatialHash();
+
+        const Entry* find(Utils::Position pos) const;
+        Entry* find(Utils::Position pos);
+
+        /// Inserts or overwrites the entry of pos.
+        void assign(Utils::Position pos, int slot, Entities::EntityType type);
+        void erase(Utils::Position pos);
+
+        size_t size() const { return count; }
+        size_t memoryBytes() const { return table.capacity() * sizeof(Entry); }
+
+    private:
+        static constexpr std::uint32_t emptyKey = 0xFFFFFFFFu;
+
+        size_t probeStart(std::uint32_t key) const;
+        void grow();
+
+        TrackedVector<Entry, MemoryTag::BOARD> table;
+        size_t mask;
+        size_t count = 0;
+    };
+}
\ No newline at end of file
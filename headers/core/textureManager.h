@@ -17,6 +17,7 @@ namespace Core {
         bool load(const std::string& id, const std::string& path);
         SDL_Texture* get(const std::string& id) const;
 
+        /// Frees every texture. Texture memory is counted as width * height * 4 bytes.
         void clear();
     };
 
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include "entities/entityType.h"
+
+namespace Core {
+
+    /// Entity layers of a board tile. A tile holds at most one entity per layer, so an actor
+    /// can stand on an item without either replacing the other.
+    enum class TileLayer : std::uint8_t
+    {
+        ACTOR,
+        ITEM
+    };
+
+    constexpr int layerCount = 2;
+
+    constexpr TileLayer layerOf(Entities::EntityType type)
+    {
+        return (type == Entities::EntityType::PLAYER || type == Entities::EntityType::ENEMY) ? TileLayer::ACTOR : TileLayer::ITEM;
+    }
+
+    /// Entity types living on layer.
+    constexpr Entities::EntityTypeMask typeMaskOf(TileLayer layer)
+    {
+        using Entities::EntityType;
+        return layer == TileLayer::ACTOR
+            ? Entities::typeMaskOf(EntityType::PLAYER) | Entities::typeMaskOf(EntityType::ENEMY)
+            : Entities::typeMaskOf(EntityType::ITEM) | Entities::typeMaskOf(EntityType::HEAL);
+    }
+
+    /// Ground of a tile, under both entity layers. Walls block movement.
+    enum class Terrain : std::uint8_t
+    {
+        FLOOR,
+        WALL
+    };
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core {
+
+    /// Fixed set of threads running the slices of one loop at a time. The calling thread
+    /// runs the first slice itself, so a pool of one thread runs everything inline.
+    class WorkerPool
+    {
+    public:
+
+        /// threads <= 0 takes one per hardware thread.
+        explicit WorkerPool(int threads = 1);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        int size() const { return threadCount; }
+
+        /// Splits [0, count) into size() contiguous slices, calls fn(worker, begin, end) on each
+        /// and returns once every slice is done. Slices only depend on count and size().
+        template <typename Fn>
+        void forEach(size_t count, Fn&& fn);
+
+    private:
+        using Call = void (*)(void* context, int worker);
+
+        /// Runs call(context, worker) for every worker, returns once all are done.
+        void run(Call call, void* context);
+        void workerLoop(int worker);
+
+        int threadCount;
+        std::vector<std::thread> threads;
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable finished;
+        Call job = nullptr;
+        void* jobContext = nullptr;
+        /// Bumped for each job, so a worker never runs the same one twice.
+        std::uint64_t generation = 0;
+        int pending = 0;
+        bool stopping = false;
+    };
+
+    template <typename Fn>
+    void WorkerPool::forEach(size_t count, Fn&& fn)
+    {
+        auto slice = [&](int worker) {
+            const size_t begin = count * worker / threadCount;
+            const size_t end = count * (worker + 1) / threadCount;
+            if (begin < end) fn(worker, begin, end);
+        };
+
+        // Type-erased by hand: no std::function, so a loop never allocates.
+        run([](void* context, int worker) { (*static_cast<decltype(slice)*>(context))(worker); }, &slice);
+    }
+}
\ No newline at end of file
@@ -2,50 +2,68 @@
 #include "entity.h"
 #include "stats.h"
 #include "enemyState.h"
+#include "moveIntent.h"
 #include "utils/position.h"
 #include "player.h"
 #include "utils/direction.h"
+#include <cstdint>
 #include <iostream>
 #include <string>
 
+namespace Systems { class PathFinder; }
+
 namespace Entities{
 
     class Player;
 
-    class Enemy : public IEntity, public std::enable_shared_from_this<Enemy>
+    class Enemy : public IEntity
     {
     public:
         
-        Enemy(const std::string _name,Stats _stats,Utils::Position _pos) : stats(_stats)
+        Enemy(Utils::NameId _name,Stats _stats,Utils::Position _pos)
         {
             type = EntityType::ENEMY;
             name = _name;
-            pos = _pos;
+            spawnPos = _pos;
+            spawnStats = _stats;
         }
 
         EnemyState getState() { return state; };
-        const Stats& getStats() { return stats; }
+        const Stats& getStats() { return statsComponent(); }
+        const DerivedStats& getDerived() const { return derivedComponent(); }
         
-        const Utils::Position& getPos() override { return pos; };
-        void setPos(Utils::Position p) override;
-        const std::string& getName() override { return name; };
-        const EntityType getType()override{ return type; };
 
-        void render(const Core::Game& g) override;
+        void render(const Core::Game& g, const SDL_Rect& rect);
 
-        void setHp(const int amount);
+        void setHp(Fixed amount);
         
-        void attack(std::shared_ptr<Player> p);
-        void chase(Core::Game& g,std::shared_ptr<Player> p);
-        void patrol(Core::Game& g);
+        /// Tiles around the enemy the chase path may go through.
+        static constexpr int chaseSearchRadius = 12;
+
+        void attack(Player& p);
+        /// Steps down the shared flow field towards the player, searches its own path with
+        /// finder when another actor stands in the way or the field has no step, patrols when
+        /// there is none. Only reads the game, so enemies can decide on several threads.
+        MoveIntent chase(const Core::Game& g, const Player& p, Systems::PathFinder& finder, std::uint32_t roll) const;
+        /// One step towards a walkable neighbour, roll picks which.
+        MoveIntent patrol(const Core::Game& g, std::uint32_t roll) const;
 
-        void move(Core::Game& g, Utils::Direction dir);
         //void collect(Core::Board& b, Utils::Position pos);
 
         void setState(EnemyState state) { this->state = state; }
 
     private:
-        Stats stats;
+        /// Up to two steps along an A* path to the player, patrols when there is none.
+        MoveIntent followPath(const Core::Game& g, const Player& p, Systems::PathFinder& finder, std::uint32_t roll) const;
+        /// true when a move from pos towards dir would be taken: a walkable tile, or the player.
+        bool canEnter(const Core::Game& g, Utils::Position pos, Utils::Direction dir) const;
+
         EnemyState state = EnemyState::PATROL;
     };
+
+    template <>
+    struct EntityKind<Enemy>
+    {
+        static constexpr EntityTypeMask mask = typeMaskOf(EntityType::ENEMY);
+    };
 }
\ No newline at end of file
@@ -1,10 +1,14 @@
 #pragma once
 #include <SDL2/SDL.h>
 #include "entityType.h"
+#include "stats.h"
+#include "core/componentStore.h"
+#include "core/entityId.h"
+#include "utils/nameTable.h"
 #include "utils/position.h"
 #include <string>
 
-namespace Core { class Game; }
+namespace Core { class Game; class EntityRegistry; }
 
 namespace Entities {
 
@@ -12,21 +16,36 @@ namespace Entities {
     {
     public:
 
-        Uint32 lastMoveTime = 0;
+        /// Position and action timer are rows of the registry's component store,
+        /// only valid once the entity is registered.
+        const Utils::Position& getPos() const { return components->positions[id.index()]; }
+        void setPos(Utils::Position p) { components->positions[id.index()] = p; }
+        std::uint32_t getNextActionTime() const { return components->nextActionTimes[id.index()]; }
+        void setNextActionTime(std::uint32_t time) { components->nextActionTimes[id.index()] = time; }
 
-        virtual const Utils::Position& getPos() = 0;
-        virtual void setPos(Utils::Position p) = 0;
-        virtual const std::string& getName() = 0;
-        virtual const EntityType getType() = 0;
+        const std::string& getName() const { return Utils::nameOf(name); }
+        Utils::NameId getNameId() const { return name; }
+        EntityType getType() const { return type; }
+        /// Handle given by the registry that owns the entity.
+        Core::EntityId getId() const { return id; }
 
-        virtual ~IEntity() = default;
+    protected:
+        /// Entities are destroyed by their pool as their concrete class, never through IEntity.
+        ~IEntity() = default;
 
-        virtual void render(const Core::Game& g) = 0;
+        /// Stats row of the entity (player and enemies).
+        Stats& statsComponent() const { return components->stats[id.index()]; }
+        DerivedStats& derivedComponent() const { return components->derived[id.index()]; }
 
-    protected:
-        Utils::Position pos;
         EntityType type;
-        std::string name;
-
+        Utils::NameId name = 0;
+        /// Initial position and stats, copied into the component store on registration.
+        Utils::Position spawnPos{0, 0};
+        Stats spawnStats{0, 0, 0};
+
+    private:
+        friend class Core::EntityRegistry;
+        Core::EntityId id;
+        Core::ComponentStore* components = nullptr;
     };
 }
\ No newline at end of file
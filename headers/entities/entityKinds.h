@@ -0,0 +1,24 @@
+#pragma once
+#include "entity.h"
+#include "player.h"
+#include "enemy.h"
+#include "swordItem.h"
+#include "healItem.h"
+
+namespace Entities {
+
+    /// Calls fn with e as its concrete class, picked by a switch on its type byte.
+    /// The set of kinds is closed, so every call is direct and can be inlined per kind.
+    template <typename Fn>
+    void visit(IEntity& e, Fn&& fn)
+    {
+        switch (e.getType())
+        {
+            case EntityType::PLAYER: fn(static_cast<Player&>(e)); break;
+            case EntityType::ENEMY:  fn(static_cast<Enemy&>(e)); break;
+            case EntityType::ITEM:   fn(static_cast<SwordItem&>(e)); break;
+            case EntityType::HEAL:   fn(static_cast<HealItem&>(e)); break;
+            case EntityType::NONE:   break;
+        }
+    }
+}
\ No newline at end of file
@@ -1,8 +1,10 @@
 #pragma once
+#include <cstdint>
 
 namespace Entities {
 
-    enum class EntityType 
+    /// Stored as one byte per tile in the board occupancy grid.
+    enum class EntityType : std::uint8_t
     {
         PLAYER,
         ENEMY,
@@ -11,4 +13,17 @@ namespace Entities {
         NONE
     };
 
+    /// Set of entity types, bit (1 << type) per type.
+    using EntityTypeMask = std::uint8_t;
+
+    constexpr EntityTypeMask typeMaskOf(EntityType type)
+    {
+        return static_cast<EntityTypeMask>(1u << static_cast<int>(type));
+    }
+
+    /// Types an entity class stands for (EntityKind<T>::mask), specialised next to each class.
+    /// The entity model is closed: a type byte is enough to know the class, without RTTI.
+    template <typename T>
+    struct EntityKind;
+
 }
\ No newline at end of file
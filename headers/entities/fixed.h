@@ -0,0 +1,55 @@
+#pragma once
+#include <compare>
+#include <cstdint>
+
+namespace Entities {
+
+    /// Signed 24.8 fixed-point number for stats. Halves and quarters are exact and every
+    /// operation is integer math, so combat gives the same result on every machine.
+    struct Fixed
+    {
+        static constexpr int fracBits = 8;
+        static constexpr std::int32_t one = 1 << fracBits;
+
+        std::int32_t raw = 0;
+
+        constexpr Fixed() = default;
+        constexpr Fixed(int value) : raw(value * one) {}
+
+        static constexpr Fixed fromRaw(std::int32_t raw)
+        {
+            Fixed f;
+            f.raw = raw;
+            return f;
+        }
+
+        /// num / den, rounded toward zero to the nearest 1/256.
+        static constexpr Fixed ratio(int num, int den)
+        {
+            return fromRaw(static_cast<std::int32_t>((std::int64_t(num) << fracBits) / den));
+        }
+
+        /// Integer part, rounded toward zero.
+        constexpr int toInt() const { return raw / one; }
+        /// Rounded up, for hit points: anything above 0 shows at least 1, matching the
+        /// healthPoint <= 0 death checks.
+        constexpr int toIntCeil() const { return raw > 0 ? (raw + one - 1) / one : raw / one; }
+
+        constexpr Fixed& operator+=(Fixed o) { raw += o.raw; return *this; }
+        constexpr Fixed& operator-=(Fixed o) { raw -= o.raw; return *this; }
+
+        friend constexpr Fixed operator+(Fixed a, Fixed b) { return a += b; }
+        friend constexpr Fixed operator-(Fixed a, Fixed b) { return a -= b; }
+        friend constexpr Fixed operator*(Fixed a, Fixed b)
+        {
+            return fromRaw(static_cast<std::int32_t>((std::int64_t(a.raw) * b.raw) >> fracBits));
+        }
+        friend constexpr Fixed operator/(Fixed a, Fixed b)
+        {
+            return fromRaw(static_cast<std::int32_t>((std::int64_t(a.raw) << fracBits) / b.raw));
+        }
+
+        friend constexpr bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+        friend constexpr auto operator<=>(Fixed a, Fixed b) { return a.raw <=> b.raw; }
+    };
+}
\ No newline at end of file
@@ -9,18 +9,16 @@ namespace Entities{
     {
     public:
 
-        Item(std::string _name,Utils::Position _pos)
+        Item(Utils::NameId _name,Utils::Position _pos)
         {
             name = _name;
-            pos = _pos;
+            spawnPos = _pos;
         };
-        virtual ~Item() = default;
-
-        const Utils::Position& getPos() override { return pos; }
-        void setPos(Utils::Position pos) override { this->pos = pos; }
-        const std::string& getName() override { return name; };
-        const EntityType getType()override{ return type; };
+    };
 
-        void render(const Core::Game& g) override = 0;
+    template <>
+    struct EntityKind<Item>
+    {
+        static constexpr EntityTypeMask mask = typeMaskOf(EntityType::ITEM) | typeMaskOf(EntityType::HEAL);
     };
 }
\ No newline at end of file
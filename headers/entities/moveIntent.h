@@ -0,0 +1,13 @@
+#pragma once
+#include <cstdint>
+#include "utils/direction.h"
+
+namespace Entities {
+
+    /// Steps an enemy wants to take this tick, in order. A step that fails cancels the next.
+    struct MoveIntent
+    {
+        Utils::Direction steps[2];
+        std::uint8_t count = 0;
+    };
+}
\ No newline at end of file
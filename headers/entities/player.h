@@ -18,46 +18,52 @@ namespace Entities{
 
     class Enemy;
     
-    class Player : public IEntity, public std::enable_shared_from_this<Player>
+    class Player : public IEntity
     {
     public:
         
         Player(Utils::Position _pos) 
-        : stats(10, 3, 2)
         {
-            this->stats.xp = 0;
-            this->stats.level = 1;
-            this->stats.maxHp = 10;
+            spawnStats = Stats(10, 3, 2);
+            spawnStats.xp = 0;
+            spawnStats.level = 1;
+            spawnStats.maxHp = 10;
     
             type = EntityType::PLAYER;
-            name = "Player";
-            pos = _pos;
+            name = Utils::intern("Player");
+            spawnPos = _pos;
         }
 
         const Systems::Inventory& getInventory() { return inventory; };
-        Stats& getStats() { return stats; };
-        const Utils::Position& getPos() override { return pos; }
-        void setPos(Utils::Position) override;
-        const std::string& getName() override { return name; };
-        const EntityType getType()override{ return type; };
+        Stats& getStats() { return statsComponent(); };
+        const DerivedStats& getDerived() const { return derivedComponent(); }
+        /// Recomputes the derived stats from the base stats and the equipped items,
+        /// call after either changes.
+        void refreshDerived(const Core::EntityRegistry& registry);
 
-        void render(const Core::Game& g) override;
+        void render(const Core::Game& g, const SDL_Rect& rect);
 
-        void attack(std::shared_ptr<Enemy> e);
+        void attack(Enemy& e);
         bool isPlayerProtecting() { return isProtecting; };
         void setPlayerProtecting() { isProtecting = true; }
-        void heal(int amount);
+        void heal(Fixed amount);
 
-        double damageWithProtect(int amount);
+        Fixed damageWithProtect(Fixed amount);
 
         void move(Core::Game& g,Utils::Direction dir);
         bool run(const int rand1,const int rand2);
-        void collect(Core::Board& board, Utils::Position pos);
-        std::shared_ptr<Enemy> getNearEnemy(Core::Board& board);
+        /// Takes the item off the board, an item that does not fit the inventory is despawned.
+        void collect(Core::Game& game, Utils::Position pos);
+        Core::EntityId getNearEnemy(Core::Board& board);
 
     private:
-        Stats stats;
         Systems::Inventory inventory;
         bool isProtecting = false;
     };
+
+    template <>
+    struct EntityKind<Player>
+    {
+        static constexpr EntityTypeMask mask = typeMaskOf(EntityType::PLAYER);
+    };
 }
\ No newline at end of file
@@ -1,23 +1,37 @@
 #pragma once
 #include <iostream>
+#include "fixed.h"
 
 namespace Entities {
 
     struct Stats
     {
-        int healthPoint;
-        int attackPoint;
-        int defensePoint;
+        Fixed healthPoint;
+        Fixed attackPoint;
+        Fixed defensePoint;
         int xp = 0;
         int level = 1;
-        int maxHp = 30;
+        Fixed maxHp = 30;
 
-        Stats(int _hp,int _attack,int _defense = 2) : healthPoint(_hp), attackPoint(_attack),
+        Stats(Fixed _hp,Fixed _attack,Fixed _defense = 2) : healthPoint(_hp), attackPoint(_attack),
             defensePoint(_defense){}
             
         void checkLvlUp();
-        void gainXp(int amount);
+        /// true when the xp made the entity level up.
+        bool gainXp(int amount);
         int getXpToNxtLvl();
 
     };
+
+    /// Effective combat values, derived from the base stats and equipment.
+    /// Cached per entity in the component store and only recomputed when an input changes.
+    struct DerivedStats
+    {
+        Fixed attack;
+        Fixed defense;
+        /// Share of an incoming hit that goes through: 100 / (100 + defense).
+        Fixed mitigation = 1;
+    };
+
+    DerivedStats deriveStats(const Stats& base, Fixed attackBonus = 0);
 }
\ No newline at end of file
@@ -8,20 +8,22 @@ namespace Entities {
     class SwordItem : public Item
     {
     public:
-        SwordItem(const std::string& _name,float _damage,Utils::Position _pos) : Item(_name,_pos),damage(_damage)
+        SwordItem(Utils::NameId _name,Fixed _damage,Utils::Position _pos) : Item(_name,_pos),damage(_damage)
         {
             type = EntityType::ITEM;
         };
 
-        const float getDamage() { return damage; }
-        const Utils::Position& getPos() override { return pos; }
-        void setPos(Utils::Position pos) override { this->pos = pos; }
-        const std::string& getName() override { return name; };
-        const EntityType getType()override{ return type; };
+        Fixed getDamage() const { return damage; }
 
-        void render(const Core::Game& g) override;
+        void render(const Core::Game& g, const SDL_Rect& rect);
 
     private:
-        float damage;
+        Fixed damage;
+    };
+
+    template <>
+    struct EntityKind<SwordItem>
+    {
+        static constexpr EntityTypeMask mask = typeMaskOf(EntityType::ITEM);
     };
 }
\ No newline at end of file
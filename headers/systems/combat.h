@@ -17,12 +17,12 @@ namespace Entities
 
 namespace Systems {
 
-    void handlePlayerTurn(Core::Game& game,Turn& turn, std::shared_ptr<Entities::Enemy> mob,
+    void handlePlayerTurn(Core::Game& game,Turn& turn, Core::EntityId mob,
                       int& selectedIndex, bool& inventorySelected,
                       bool& isCombatOver);
 
-    void handleMobTurn(Core::Game& game, std::shared_ptr<Entities::Enemy> mob);
+    void handleMobTurn(Core::Game& game, Core::EntityId mob);
     void StartFight(Core::Game& game,
-                std::shared_ptr<Entities::Enemy> e);
+                Core::EntityId e);
 
 }
\ No newline at end of file
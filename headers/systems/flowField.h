@@ -0,0 +1,93 @@
+#pragma once
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <span>
+#include "core/boardJournal.h"
+#include "core/config.h"
+#include "core/memoryTracker.h"
+#include "utils/direction.h"
+#include "utils/grid.h"
+#include "utils/position.h"
+
+namespace Core { class Board; }
+
+namespace Systems {
+
+    /// Walking distance from every tile of a window to a goal (the player), with the step each
+    /// tile takes towards it, so any number of chasers read their next move in O(1).
+    ///
+    /// Only walls are obstacles: actors move every tick, chasers step around each other on
+    /// their own. Updates repair the field instead of rebuilding it (LPA* without a heuristic):
+    /// moving the goal or a few walls revisits only the tiles whose distance changes. The window
+    /// is rebuilt around the goal once the goal gets more than radius / 2 from its center.
+    class FlowField
+    {
+    public:
+
+        explicit FlowField(int radius = 24);
+
+        void setGoal(const Core::Board& board, Utils::Position goal);
+        /// Repairs the field after the TERRAIN changes of a journal.
+        void applyChanges(const Core::Board& board, std::span<const Core::BoardChange> changes);
+
+        /// Next step from pos towards the goal. false on the goal itself, outside the window,
+        /// or when walls cut pos off from the goal.
+        bool stepFrom(Utils::Position pos, Utils::Direction& dir) const;
+        /// Steps from pos to the goal, -1 when there is no way inside the window.
+        int distanceFrom(Utils::Position pos) const;
+
+        bool hasGoal() const { return goalTile >= 0; }
+        /// Tiles whose distance changed in the last update.
+        size_t getLastRepairCount() const { return lastRepairCount; }
+
+    private:
+        static constexpr int unreachable = INT_MAX / 2;
+        static constexpr int noTile = -1;
+        static constexpr std::uint8_t noStep = 4;
+
+        template <typename Grid>
+        void rebuild(const Core::Board& board, const Grid& grid, Utils::Position goal);
+        /// Recomputes the one-step estimate of tile from its neighbours, and queues it while
+        /// the estimate and its distance differ.
+        void updateTile(int tile);
+        /// Settles every queued tile, then refreshes the steps around the changed ones.
+        void repair();
+        void refreshStep(int tile);
+        int indexOf(Utils::Position pos) const;
+        /// Files tile in the bucket of the smaller of its distance and estimate.
+        void push(int tile);
+        void unlink(int tile);
+        void markChanged(int tile);
+
+        int radius;
+        Core::Size boardSize;
+        Utils::Position anchor;
+        Utils::GridWindow window;
+        int goalTile = -1;
+
+        /// Per window tile: settled distance, one-step estimate (1 + best neighbour), wall flag
+        /// and step towards the goal (a Utils::Direction, or noStep).
+        Core::TrackedVector<int, Core::MemoryTag::AI> distances;
+        Core::TrackedVector<int, Core::MemoryTag::AI> estimates;
+        Core::TrackedVector<std::uint8_t, Core::MemoryTag::AI> walls;
+        Core::TrackedVector<std::uint8_t, Core::MemoryTag::AI> steps;
+        /// Window index of the tile's neighbours in Utils::Direction order, noTile off the window.
+        Core::TrackedVector<std::array<int, 4>, Core::MemoryTag::AI> neighbours;
+
+        /// Tiles whose distance and estimate differ, in buckets by the smaller of the two. Every
+        /// step costs one, so the keys settled never go down and the lowest bucket only moves up.
+        /// A tile sits in at most one bucket, linked through nextQueued / previousQueued.
+        Core::TrackedVector<int, Core::MemoryTag::AI> buckets;
+        Core::TrackedVector<int, Core::MemoryTag::AI> queuedKeys;
+        Core::TrackedVector<int, Core::MemoryTag::AI> nextQueued;
+        Core::TrackedVector<int, Core::MemoryTag::AI> previousQueued;
+        size_t lowestBucket = 0;
+        size_t queued = 0;
+
+        /// Tiles whose distance changed during the current update, flagged once.
+        Core::TrackedVector<int, Core::MemoryTag::AI> changed;
+        Core::TrackedVector<std::uint8_t, Core::MemoryTag::AI> changedFlags;
+        size_t lastRepairCount = 0;
+    };
+}
\ No newline at end of file
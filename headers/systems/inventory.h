@@ -2,26 +2,33 @@
 #include <vector>
 #include <iostream>
 #include "entities/item.h"
-#include <memory>
+#include "core/entityId.h"
+#include "core/memoryTracker.h"
 
 namespace Systems {
 
     class Inventory
     {
     public:
-        
+        using Items = Core::TrackedVector<Core::EntityId, Core::MemoryTag::INVENTORY>;
+
         Inventory();
         
         size_t getMaxSize() const;
         size_t getSize() const;
-        const std::vector<std::shared_ptr<Entities::Item>>& getItems() const { return items; };
+        /// Handles on items of the game registry.
+        const Items& getItems() const { return items; };
         
-        void addItem(std::shared_ptr<Entities::Item> item);
-        void removeItem(const std::string& name);
-        void pop();
+        /// false when the inventory is full, the caller keeps the item.
+        bool addItem(Core::EntityId item);
+        /// Takes the item out and hands its handle back, the caller destroys or
+        /// places it. Null when the item is not in the inventory.
+        Core::EntityId removeItem(Core::EntityId item);
+        /// Same as removeItem for the last item, null when empty.
+        Core::EntityId pop();
         
     private:
-        std::vector<std::shared_ptr<Entities::Item>> items;
+        Items items;
         const short InventorySize = 5;
     };
 }
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include "core/memoryTracker.h"
+#include "utils/direction.h"
+#include "utils/position.h"
+
+namespace Core { class Board; }
+
+namespace Systems {
+
+    /// A* over the walkable tiles of a board, with a Manhattan heuristic that goes across the
+    /// edges of a WRAP board. The search stays in a window around the start, and its buffers
+    /// are kept between queries, so searches stop allocating once they have seen the biggest window.
+    class PathFinder
+    {
+    public:
+
+        /// Searches a shortest path from from to to among the tiles at most radius away from
+        /// from on each axis. to is entered even when it blocks movement, so a chaser can path
+        /// onto its target. false when to is out of the window or cannot be reached.
+        bool findPath(const Core::Board& board, Utils::Position from, Utils::Position to, int radius);
+
+        /// Steps of the last path found, first step first. Empty when from was to.
+        std::span<const Utils::Direction> getPath() const { return path; }
+        /// Tiles expanded by the last search.
+        int getExpanded() const { return expanded; }
+
+    private:
+        struct OpenNode
+        {
+            int f;
+            int h;
+            int tile;
+        };
+
+        template <typename Grid>
+        bool search(const Core::Board& board, const Grid& grid, Utils::Position from, Utils::Position to, int radius);
+        /// Stamps above the current query's, or a restart of the counter when it would overflow.
+        void nextQuery(size_t tiles);
+
+        /// Per window tile: stamp of the last query that reached it (2q open, 2q + 1 closed),
+        /// best cost so far and the step that led there.
+        Core::TrackedVector<std::uint32_t, Core::MemoryTag::AI> stamps;
+        Core::TrackedVector<int, Core::MemoryTag::AI> costs;
+        Core::TrackedVector<Utils::Direction, Core::MemoryTag::AI> cameFrom;
+        /// Binary heap on (f, h, tile), stale entries are skipped when popped.
+        Core::TrackedVector<OpenNode, Core::MemoryTag::AI> open;
+        Core::TrackedVector<Utils::Direction, Core::MemoryTag::AI> path;
+        std::uint32_t query = 0;
+        int expanded = 0;
+    };
+}
\ No newline at end of file
@@ -1,10 +1,14 @@
 #pragma once
 #include <iostream>
 #include <SDL2/SDL.h>
+#include <cstdint>
 #include <vector>
 #include <string>
-#include <memory>
+#include <unordered_map>
+#include "core/entityId.h"
 #include "systems/turn.h"
+#include "utils/nameTable.h"
+#include "utils/position.h"
 
 
 namespace Core { struct Game; }
@@ -19,8 +23,13 @@ namespace UI {
         void drawBoard(const Core::Game& g) const;
         void drawInfo(const Core::Game& g) const;
         void renderPlayerInfo(Core::Game& g);
-        void renderText(const Core::Game& g, const std::string& text,
+        void renderText(const Core::Game& g, const char* text,
                         int x, int y, SDL_Color c);
+        /// Draws an interned label from a texture cached per id and color, returns its width.
+        int renderLabel(const Core::Game& g, Utils::NameId label,
+                        int x, int y, SDL_Color c);
+        /// Frees the cached label textures, call before the renderer is destroyed.
+        void clearTextCache();
         void drawTitleScreen(const Core::Game& g);
         void drawPauseScreen(const Core::Game& g);
         void drawGameOverScreen(const Core::Game& g);
@@ -29,15 +38,27 @@ namespace UI {
         void DisplayRect(SDL_Renderer* renderer,int x, int y,const std::vector<std::string>& options);
 
         void drawCombat(Core::Game& g,
-                std::shared_ptr<Entities::Enemy> mob,
+                Core::EntityId mob,
                 Systems::Turn currentTurn,
                 int selectedIndex,
                 bool isInventorySelected);
         
     private:
-        void drawCombatSprites(Core::Game& g, std::shared_ptr<Entities::Enemy> mob);
-        void drawCombatHUD(Core::Game& g, std::shared_ptr<Entities::Enemy> mob);
+        /// Board tile drawn in the top-left corner of the screen.
+        Utils::Position viewOrigin(const Core::Game& g) const;
+
+        void drawCombatSprites(Core::Game& g, Entities::Enemy& mob);
+        void drawCombatHUD(Core::Game& g, Entities::Enemy& mob);
         void drawCombatMenu(Core::Game& g, int selectedIndex);
-        void drawCombatTurn(Core::Game& g, std::shared_ptr<Entities::Enemy> mob, Systems::Turn turn);
+        void drawCombatTurn(Core::Game& g, Entities::Enemy& mob, Systems::Turn turn);
+
+        struct CachedText
+        {
+            SDL_Texture* texture = nullptr;
+            int w = 0;
+            int h = 0;
+        };
+        /// Keyed by label id in the high half and RGBA color in the low half.
+        std::unordered_map<std::uint64_t, CachedText> textCache;
     };
 }
\ No newline at end of file
@@ -0,0 +1,181 @@
+#pragma once
+#include "direction.h"
+#include "position.h"
+#include "core/config.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace Utils
+{
+    /// Neighbour, index and distance math of a board with the given topology. Height and Width
+    /// of 0 are read from the Size at run time. Sizes fixed at compile time fold into constants,
+    /// and power-of-two ones turn the wraparound and the row stride into masks and shifts.
+    template <Core::Topology Topo, int Height = 0, int Width = 0>
+    class Grid
+    {
+    public:
+        static constexpr Core::Topology topology = Topo;
+
+        constexpr explicit Grid(const Core::Size& size) : rows(size.height), cols(size.width) {}
+
+        constexpr int height() const { if constexpr (Height > 0) return Height; else return rows; }
+        constexpr int width() const { if constexpr (Width > 0) return Width; else return cols; }
+
+        constexpr bool contains(Position p) const
+        {
+            return static_cast<unsigned>(p.x) < static_cast<unsigned>(height())
+                && static_cast<unsigned>(p.y) < static_cast<unsigned>(width());
+        }
+
+        /// Row-major index of a tile on the board.
+        constexpr int index(Position p) const
+        {
+            if constexpr (isPowerOfTwo(Width)) return (p.x << log2(Width)) | p.y;
+            else return p.x * width() + p.y;
+        }
+
+        /// The tile one step towards dir. Past the edge of a BOUNDED board this is pos itself.
+        constexpr Position step(Position pos, Direction dir) const
+        {
+            // Offsets by table rather than a switch: the direction is usually random.
+            constexpr int rowStep[4] = {-1, 1, 0, 0};
+            constexpr int colStep[4] = {0, 0, -1, 1};
+            const Position next{pos.x + rowStep[dir], pos.y + colStep[dir]};
+
+            if constexpr (Topo == Core::Topology::WRAP)
+                return { wrap<Height>(next.x, height()), wrap<Width>(next.y, width()) };
+            else
+                return contains(next) ? next : pos;
+        }
+
+        /// Steps between two tiles on a board without obstacles, across the edges on a WRAP board.
+        constexpr int manhattanDistance(Position a, Position b) const
+        {
+            return axisDistance(a.x, b.x, height()) + axisDistance(a.y, b.y, width());
+        }
+
+        /// Squared length of the shortest way between two tiles, across the edges on a WRAP board.
+        constexpr int distanceSquared(Position a, Position b) const
+        {
+            const int dx = axisDistance(a.x, b.x, height());
+            const int dy = axisDistance(a.y, b.y, width());
+            return dx * dx + dy * dy;
+        }
+
+    private:
+        static constexpr bool isPowerOfTwo(int n) { return n > 0 && (n & (n - 1)) == 0; }
+        static constexpr int log2(int n) { int s = 0; while ((1 << s) < n) ++s; return s; }
+
+        /// Brings a coordinate at most one board length off back on the board.
+        template <int N>
+        static constexpr int wrap(int v, int n)
+        {
+            if constexpr (isPowerOfTwo(N)) return v & (N - 1);
+            else return v < 0 ? v + n : (v >= n ? v - n : v);
+        }
+
+        static constexpr int axisDistance(int a, int b, int n)
+        {
+            const int d = std::abs(a - b);
+            if constexpr (Topo == Core::Topology::WRAP) return d < n - d ? d : n - d;
+            else return d;
+        }
+
+        int rows;
+        int cols;
+    };
+
+    /// Square window of a board around a tile, following the board topology: wrapping around
+    /// the edges of a WRAP board, cut at the edges of a BOUNDED one. Tiles are indexed row-major.
+    struct GridWindow
+    {
+        Position origin;
+        int rows = 0;
+        int cols = 0;
+
+        /// Tiles at most radius away from center on each axis.
+        template <typename G>
+        static GridWindow around(const G& grid, Position center, int radius)
+        {
+            GridWindow window;
+            if constexpr (G::topology == Core::Topology::WRAP)
+            {
+                window.rows = std::min(2 * radius + 1, grid.height());
+                window.cols = std::min(2 * radius + 1, grid.width());
+                window.origin.x = window.rows < grid.height() ? (center.x - radius + grid.height()) % grid.height() : 0;
+                window.origin.y = window.cols < grid.width() ? (center.y - radius + grid.width()) % grid.width() : 0;
+            }
+            else
+            {
+                window.origin = {std::max(0, center.x - radius), std::max(0, center.y - radius)};
+                window.rows = std::max(0, std::min(grid.height() - 1, center.x + radius) - window.origin.x + 1);
+                window.cols = std::max(0, std::min(grid.width() - 1, center.y + radius) - window.origin.y + 1);
+            }
+            return window;
+        }
+
+        int size() const { return rows * cols; }
+
+        /// Index of a board tile in the window, -1 outside.
+        template <typename G>
+        int indexOf(const G& grid, Position pos) const
+        {
+            int r = pos.x - origin.x;
+            int c = pos.y - origin.y;
+            if constexpr (G::topology == Core::Topology::WRAP)
+            {
+                if (r < 0) r += grid.height();
+                if (c < 0) c += grid.width();
+            }
+
+            if (r < 0 || c < 0 || r >= rows || c >= cols) return -1;
+            return r * cols + c;
+        }
+
+        template <typename G>
+        Position positionOf(const G& grid, int index) const
+        {
+            Position pos{origin.x + index / cols, origin.y + index % cols};
+            if constexpr (G::topology == Core::Topology::WRAP)
+            {
+                if (pos.x >= grid.height()) pos.x -= grid.height();
+                if (pos.y >= grid.width()) pos.y -= grid.width();
+            }
+            return pos;
+        }
+    };
+
+    /// Calls fn(grid) for a Grid of this topology, specialised for square boards of the default
+    /// 19 tiles or a power of two from 32 to 4096, and sized at run time for anything else.
+    template <Core::Topology Topo, typename Fn>
+    auto withSizedGrid(const Core::Size& size, Fn&& fn)
+    {
+        if (size.width == size.height)
+        {
+            switch (size.width)
+            {
+            case 19: return fn(Grid<Topo, 19, 19>(size));
+            case 32: return fn(Grid<Topo, 32, 32>(size));
+            case 64: return fn(Grid<Topo, 64, 64>(size));
+            case 128: return fn(Grid<Topo, 128, 128>(size));
+            case 256: return fn(Grid<Topo, 256, 256>(size));
+            case 512: return fn(Grid<Topo, 512, 512>(size));
+            case 1024: return fn(Grid<Topo, 1024, 1024>(size));
+            case 2048: return fn(Grid<Topo, 2048, 2048>(size));
+            case 4096: return fn(Grid<Topo, 4096, 4096>(size));
+            default: break;
+            }
+        }
+        return fn(Grid<Topo>(size));
+    }
+
+    /// Runtime dispatch into the Grid instantiation matching size. Pays one switch, so call it
+    /// around a loop rather than inside one.
+    template <typename Fn>
+    auto withGrid(const Core::Size& size, Fn&& fn)
+    {
+        if (size.topology == Core::Topology::BOUNDED)
+            return withSizedGrid<Core::Topology::BOUNDED>(size, fn);
+        return withSizedGrid<Core::Topology::WRAP>(size, fn);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+
+namespace Utils
+{
+    /// Spreads the low 16 bits of v to the even bits of the result.
+    constexpr std::uint32_t spreadBits(std::uint32_t v)
+    {
+        v &= 0xFFFFu;
+        v = (v | (v << 8)) & 0x00FF00FFu;
+        v = (v | (v << 4)) & 0x0F0F0F0Fu;
+        v = (v | (v << 2)) & 0x33333333u;
+        v = (v | (v << 1)) & 0x55555555u;
+        return v;
+    }
+
+    /// Inverse of spreadBits.
+    constexpr std::uint32_t compactBits(std::uint32_t v)
+    {
+        v &= 0x55555555u;
+        v = (v | (v >> 1)) & 0x33333333u;
+        v = (v | (v >> 2)) & 0x0F0F0F0Fu;
+        v = (v | (v >> 4)) & 0x00FF00FFu;
+        v = (v | (v >> 8)) & 0x0000FFFFu;
+        return v;
+    }
+
+    /// Z-order index of (row, col): bits interleaved, row on the odd bits. Tiles close on the
+    /// board get close indices, so a small square window spans few cache lines.
+    constexpr std::uint32_t mortonEncode(std::uint32_t row, std::uint32_t col)
+    {
+        return (spreadBits(row) << 1) | spreadBits(col);
+    }
+
+    constexpr std::uint32_t mortonRow(std::uint32_t index) { return compactBits(index >> 1); }
+    constexpr std::uint32_t mortonCol(std::uint32_t index) { return compactBits(index); }
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Utils {
+
+    /// Interned string id, 0 is the empty name.
+    using NameId = std::uint32_t;
+
+    /// Append-only table giving every distinct name one 32-bit id.
+    /// Strings never move once interned, so references and views stay valid
+    /// for the life of the table.
+    class NameTable
+    {
+    public:
+
+        NameTable();
+
+        /// Id of the name, added to the table the first time it is seen.
+        NameId intern(std::string_view text);
+        const std::string& str(NameId id) const;
+
+        std::size_t size() const { return strings.size(); }
+
+    private:
+        std::deque<std::string> strings;
+        /// Keys view the strings above.
+        std::unordered_map<std::string_view, NameId> ids;
+    };
+
+    /// Table shared by the whole game. Interning is not thread-safe, do it on the game thread.
+    NameTable& nameTable();
+
+    inline NameId intern(std::string_view text) { return nameTable().intern(text); }
+    inline const std::string& nameOf(NameId id) { return nameTable().str(id); }
+}
\ No newline at end of file
@@ -1,16 +1,19 @@
 #pragma once
 #include "direction.h"
 #include "position.h"
+#include "nameTable.h"
 #include "core/board.h"
 #include "entities/player.h"
 #include "entities/enemy.h"
 #include "entities/healItem.h"
+#include <cstdint>
 #include <math.h>
 #include <random>
 
 namespace Core
 { 
     class Board;
+    struct Size;
 }
 
 namespace Entities
@@ -25,11 +28,12 @@ namespace Utils {
     static const std::string names[8] = {"Miku","Teto","Neru","Dante","Rosalina","Borat","GojoTurk","Bunbun"};
     static const std::vector<std::string> options = {"Attack", "Protect", "Inventory", "Run"};
     
-    Direction getRandDir();
-    Position generateRandomPosition(Core::Board& board);
-    Position getDirection(int posX, int posY, Utils::Direction dir);
-    std::string generateRandomName();
-    int calculateDistance(std::shared_ptr<Entities::Enemy> mob,std::shared_ptr<Entities::Player> player);
-    std::vector<std::shared_ptr<Entities::HealItem>> getHealInBoard(Core::Board& board);
-    void HealPlayerOnItem(std::shared_ptr<Entities::Player> player,Core::Board& board, Position pos);
+    /// 32 well-mixed bits of two keys (splitmix64), for random draws that must come out the
+    /// same whatever the order or thread they are made on.
+    std::uint32_t mix(std::uint64_t a, std::uint64_t b);
+    /// Empty tile in the resident chunks, false when there is none (the spawn is to be skipped).
+    bool generateRandomPosition(Core::Board& board, Position& pos);
+    Position getDirection(int posX, int posY, Utils::Direction dir, const Core::Size& size);
+    NameId generateRandomName();
+    void HealPlayerOnItem(Entities::Player& player,Core::Board& board, Position pos);
 }
\ No newline at end of file
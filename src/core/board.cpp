@@ -1,68 +1,925 @@
 #include "core/board.h"
+#include "utils/util.h"
+#include "utils/grid.h"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <tuple>
 
-void Core::Board::setEntityAt(Utils::Position pos, std::shared_ptr<Entities::IEntity> e)
+Core::Board::Chunk::Chunk()
 {
+    for (int layer = 0; layer < layerCount; ++layer)
+    {
+        std::fill(std::begin(slots[layer]), std::end(slots[layer]), -1);
+        std::fill(std::begin(types[layer]), std::end(types[layer]), Entities::EntityType::NONE);
+    }
+    std::fill(std::begin(terrain), std::end(terrain), Terrain::FLOOR);
+}
+
+bool Core::Board::Chunk::hasAny(Entities::EntityTypeMask typeMask) const
+{
+    for (int t = 0; t < typeCount; ++t)
+        if (typeCounts[t] > 0 && (typeMask & Entities::typeMaskOf(static_cast<Entities::EntityType>(t))))
+            return true;
+    return false;
+}
+
+Core::Board::Board(EntityRegistry& _registry, Size size, StreamingConfig streaming, BoardBackend _backend)
+    : registry(_registry),
+      boardSize(size),
+      backend(_backend),
+      chunkRows((size.height + chunkSize - 1) >> chunkShift),
+      chunkCols((size.width + chunkSize - 1) >> chunkShift),
+      residentRadius(streaming.residentRadius)
+{
+    const size_t chunkCount = static_cast<size_t>(chunkRows) * chunkCols;
+
+    if (backend == BoardBackend::DENSE)
+    {
+        store = std::make_unique<ChunkStore>(streaming.chunkDirectory);
+        chunks.resize(chunkCount);
+        storedCounts.resize(chunkCount);
+        chunkStates.assign(chunkCount, ChunkState::EMPTY);
+    }
+
+    snapshotCache.resize(chunkCount);
+    snapshotDirty.assign(chunkCount, 0);
+}
+
+size_t Core::Board::getTileMemoryBytes() const
+{
+    if (backend == BoardBackend::SPARSE)
+    {
+        size_t bytes = sparseTerrain.memoryBytes();
+        for (const auto& tiles : sparseTiles) bytes += tiles.memoryBytes();
+        return bytes;
+    }
+
+    return loadedChunks * sizeof(Chunk) + chunks.capacity() * sizeof(chunks[0]) + chunkStates.capacity();
+}
+
+Core::Board::TileInfo Core::Board::readTile(Utils::Position pos, TileLayer layer) const
+{
+    const int l = static_cast<int>(layer);
+
+    if (backend == BoardBackend::SPARSE)
+    {
+        const SpatialHash::Entry* entry = isInside(pos) ? sparseTiles[l].find(pos) : nullptr;
+        return entry ? TileInfo{entry->slot, entry->type} : TileInfo{-1, Entities::EntityType::NONE};
+    }
+
+    int chunk = chunkIndex(pos);
+    if (chunk < 0 || !chunks[chunk]) return {-1, Entities::EntityType::NONE};
+
+    int tile = localIndex(pos);
+    return {chunks[chunk]->slots[l][tile], chunks[chunk]->types[l][tile]};
+}
+
+void Core::Board::writeTile(Utils::Position pos, TileLayer layer, int slot, Entities::EntityType type)
+{
+    touch(pos);
+
+    if (backend == BoardBackend::SPARSE)
+    {
+        SpatialHash& tiles = sparseTiles[static_cast<int>(layer)];
+        if (type == Entities::EntityType::NONE) tiles.erase(pos);
+        else tiles.assign(pos, slot, type);
+        return;
+    }
+
+    setTile(*chunks[chunkIndex(pos)], pos, layer, slot, type);
+}
+
+int Core::Board::chunkIndex(Utils::Position pos) const
+{
+    if (pos.x < 0 || pos.y < 0 || pos.x >= boardSize.height || pos.y >= boardSize.width)
+        return -1;
+    return (pos.x >> chunkShift) * chunkCols + (pos.y >> chunkShift);
+}
+
+Core::Board::Chunk* Core::Board::materialize(int chunk)
+{
+    if (chunks[chunk]) return chunks[chunk].get();
+
+    chunks[chunk] = std::make_unique<Chunk>();
+    ++loadedChunks;
+
+    bool onDisk = chunkStates[chunk] == ChunkState::ON_DISK;
+    chunkStates[chunk] = ChunkState::LOADED;
+
+    if (onDisk)
+    {
+        // Its entities are counted as loaded again as they are placed.
+        for (int t = 0; t < typeCount; ++t)
+            storedTotals[t] -= storedCounts[chunk][t];
+        storedCounts[chunk] = {};
+
+        Chunk& c = *chunks[chunk];
+        const Utils::Position corner{(chunk / chunkCols) << chunkShift, (chunk % chunkCols) << chunkShift};
+        Terrain terrain[chunkSize * chunkSize];
+        std::fill(std::begin(terrain), std::end(terrain), Terrain::FLOOR);
+
+        std::vector<EntityId> loaded = store->load(chunk, registry, terrain);
+        for (int tile = 0; tile < chunkSize * chunkSize; ++tile)
+        {
+            if (terrain[tile] == Terrain::FLOOR) continue;
+
+            const Utils::Position pos{corner.x + (tile >> chunkShift), corner.y + (tile & (chunkSize - 1))};
+            setTerrain(c, pos, terrain[tile]);
+            journal.record({BoardChange::Kind::TERRAIN, Entities::EntityType::NONE, pos, pos, {}});
+        }
+
+        for (EntityId id : loaded)
+            if (id) setEntityAt(registry.getComponents().positions[id.index()], id);
+    }
+
+    return chunks[chunk].get();
+}
+
+void Core::Board::evict(int chunk)
+{
+    const Chunk& c = *chunks[chunk];
+    std::vector<Entities::IEntity*> evicted;
+    evicted.reserve(c.entityCount);
+
+    // The player's chunk always stays in memory.
+    if (c.typeCounts[static_cast<int>(Entities::EntityType::PLAYER)] > 0) return;
+
+    for (int layer = 0; layer < layerCount; ++layer)
+        for (int i = 0; i < chunkSize * chunkSize; ++i)
+            if (c.slots[layer][i] >= 0) evicted.push_back(registry.get(entities[c.slots[layer][i]]));
+
+    const bool empty = evicted.empty() && c.wallCount == 0;
+    std::span<const Terrain> terrain;
+    if (c.wallCount > 0) terrain = c.terrain;
+
+    if (!empty && !store->save(chunk, evicted, terrain)) return;
+
+    for (int t = 0; t < typeCount; ++t)
+    {
+        storedCounts[chunk][t] = c.typeCounts[t];
+        storedTotals[t] += c.typeCounts[t];
+    }
+
+    // The saved copies replace the entities, handles on them become stale.
+    for (auto* e : evicted)
+        deleteEntityAt(e->getPos(), layerOf(e->getType()));
+
+    // Walls of unloaded chunks read as floor until they come back.
+    if (c.wallCount > 0)
+    {
+        const Utils::Position corner{(chunk / chunkCols) << chunkShift, (chunk % chunkCols) << chunkShift};
+        for (int tile = 0; tile < chunkSize * chunkSize; ++tile)
+        {
+            if (c.terrain[tile] == Terrain::FLOOR) continue;
+
+            const Utils::Position pos{corner.x + (tile >> chunkShift), corner.y + (tile & (chunkSize - 1))};
+            journal.record({BoardChange::Kind::TERRAIN, Entities::EntityType::NONE, pos, pos, {}});
+        }
+    }
+
+    chunks[chunk].reset();
+    --loadedChunks;
+    chunkStates[chunk] = empty ? ChunkState::EMPTY : ChunkState::ON_DISK;
+}
+
+bool Core::Board::isChunkResident(int chunk) const
+{
+    if (!hasResidencyCenter) return true;
+
+    // In chunks, around the board edges only on a WRAP board.
+    auto distance = [&](int a, int b, int n) {
+        int d = std::abs(a - b);
+        return boardSize.topology == Topology::WRAP ? std::min(d, n - d) : d;
+    };
+
+    return distance(chunk / chunkCols, residencyCenter.x, chunkRows) <= residentRadius
+        && distance(chunk % chunkCols, residencyCenter.y, chunkCols) <= residentRadius;
+}
+
+void Core::Board::updateResidency(Utils::Position center)
+{
+    if (backend == BoardBackend::SPARSE) return;
+
+    Utils::Position centerChunk{center.x >> chunkShift, center.y >> chunkShift};
+    if (hasResidencyCenter && centerChunk == residencyCenter) return;
+
+    hasResidencyCenter = true;
+    residencyCenter = centerChunk;
+
+    for (int chunk = 0; chunk < static_cast<int>(chunks.size()); ++chunk)
+    {
+        bool resident = isChunkResident(chunk);
+
+        if (!resident && chunks[chunk])
+            evict(chunk);
+        else if (resident && chunkStates[chunk] == ChunkState::ON_DISK)
+            materialize(chunk);
+    }
+}
+
+bool Core::Board::isTileResident(Utils::Position pos) const
+{
+    if (backend == BoardBackend::SPARSE) return isInside(pos);
+
+    int chunk = chunkIndex(pos);
+    return chunk >= 0 && isChunkResident(chunk);
+}
+
+Core::TileArea Core::Board::getResidentArea() const
+{
+    TileArea area{{0, 0}, boardSize.height, boardSize.width};
+    if (!hasResidencyCenter) return area;
+
+    if (boardSize.topology == Topology::BOUNDED)
+    {
+        // Cut at the board edges, there is nothing past them.
+        const int firstRow = std::max(0, residencyCenter.x - residentRadius);
+        const int lastRow = std::min(chunkRows - 1, residencyCenter.x + residentRadius);
+        const int firstCol = std::max(0, residencyCenter.y - residentRadius);
+        const int lastCol = std::min(chunkCols - 1, residencyCenter.y + residentRadius);
+
+        area.origin = {firstRow << chunkShift, firstCol << chunkShift};
+        area.height = std::min(boardSize.height, (lastRow + 1) << chunkShift) - area.origin.x;
+        area.width = std::min(boardSize.width, (lastCol + 1) << chunkShift) - area.origin.y;
+        return area;
+    }
+
+    const int span = 2 * residentRadius + 1;
+
+    if (span < chunkRows)
+    {
+        area.origin.x = ((residencyCenter.x - residentRadius + chunkRows) % chunkRows) << chunkShift;
+        area.height = span << chunkShift;
+    }
+    if (span < chunkCols)
+    {
+        area.origin.y = ((residencyCenter.y - residentRadius + chunkCols) % chunkCols) << chunkShift;
+        area.width = span << chunkShift;
+    }
+    return area;
+}
+
+void Core::Board::setEntityAt(Utils::Position pos, EntityId id)
+{
+    Entities::IEntity* e = registry.get(id);
     if (!e) {
-        deleteEntityAt(pos);
+        std::cerr << "Invalid entity handle: " << id.value << std::endl;
         return;
     }
 
-    if (pos.x < 0 || pos.y < 0 || pos.x >= boardSize.boardSize || pos.y >= boardSize.boardSize)
+    if (!isInside(pos))
     {
         std::cerr << "Invalid Position: (" << pos.x << ", " << pos.y << ")" << std::endl;
         return;
     }
 
-    deleteEntityAt(pos);
+    if (backend == BoardBackend::DENSE)
+        materialize(chunkIndex(pos));
+
+    const TileLayer layer = layerOf(e->getType());
+    TileInfo current = readTile(pos, layer);
+    if (current.slot >= 0 && entities[current.slot] == id) return;
+    deleteEntityAt(pos, layer);
+
+    // An entity already on the board is moved: its old tile is freed and its slot reused.
+    int slot = -1;
+    TileInfo old = readTile(e->getPos(), layer);
+
+    if (old.slot >= 0 && entities[old.slot] == id)
+    {
+        writeTile(e->getPos(), layer, -1, Entities::EntityType::NONE);
+        slot = old.slot;
+        journal.record({BoardChange::Kind::MOVE, e->getType(), e->getPos(), pos, id});
+    }
+
+    if (slot < 0)
+    {
+        slot = insertSlot(e->getType());
+        journal.record({BoardChange::Kind::SPAWN, e->getType(), pos, pos, id});
+    }
 
     e->setPos(pos);
-    entities.push_back(e);
+    entities[slot] = id;
+    entityPositions[slot] = pos;
+
+    writeTile(pos, layer, slot, e->getType());
+}
+
+void Core::Board::deleteEntityAt(Utils::Position pos, TileLayer layer)
+{
+    registry.destroy(detach(pos, layer));
+}
+
+Core::EntityId Core::Board::takeEntityAt(Utils::Position pos, TileLayer layer)
+{
+    return detach(pos, layer);
+}
+
+Core::EntityId Core::Board::detach(Utils::Position pos, TileLayer layer)
+{
+    TileInfo tile = readTile(pos, layer);
+    if (tile.slot < 0) return {};
+
+    EntityId id = entities[tile.slot];
+    journal.record({BoardChange::Kind::DESPAWN, tile.type, pos, pos, id});
+    removeSlot(tile.slot);
+    return id;
 }
 
-void Core::Board::deleteEntityAt(Utils::Position pos)
+void Core::Board::relocate(int slot, Utils::Position to)
 {
-    for (auto it = entities.begin(); it != entities.end(); ) {
-        if ((*it)->getPos() == pos) {
-            it = entities.erase(it);
-        } else {
-            ++it;
+    Utils::Position from = entityPositions[slot].unpack();
+    Entities::EntityType type = typeOfSlot(slot);
+    const TileLayer layer = layerOf(type);
+
+    if (readTile(from, layer).slot == slot)
+        writeTile(from, layer, -1, Entities::EntityType::NONE);
+    writeTile(to, layer, slot, type);
+
+    entityPositions[slot] = to;
+    registry.getComponents().positions[entities[slot].index()] = to;
+    journal.record({BoardChange::Kind::MOVE, type, from, to, entities[slot]});
+}
+
+Core::MoveResult Core::Board::moveEntity(Utils::Position from, Utils::Position to)
+{
+    if (!isInside(from) || !isInside(to)) return MoveResult::INVALID;
+
+    // Only updateResidency brings chunks back from disk: a target outside them is blocked.
+    if (!isTileResident(to)) return MoveResult::OCCUPIED;
+
+    // Creating the target chunk may insert entities, so read slots afterwards.
+    if (backend == BoardBackend::DENSE)
+        materialize(chunkIndex(to));
+
+    int slot = readTile(from, TileLayer::ACTOR).slot;
+    if (slot < 0) return MoveResult::NO_ENTITY;
+    if (from == to) return MoveResult::MOVED;
+    if (readTile(to, TileLayer::ACTOR).slot >= 0 || getTerrainAt(to) == Terrain::WALL) return MoveResult::OCCUPIED;
+
+    relocate(slot, to);
+    return MoveResult::MOVED;
+}
+
+void Core::Board::applyMoves(std::span<const Move> moves, std::span<MoveResult> results)
+{
+    enum : std::uint8_t { PENDING, DONE, MOVING, BLOCKED, VISITING };
+
+    const int n = static_cast<int>(std::min(moves.size(), results.size()));
+    auto& [order, slots, dependsOn, states, stack] = moveScratch;
+
+    slots.assign(n, -1);
+    dependsOn.assign(n, -1);
+    states.assign(n, DONE);
+    order.clear();
+
+    if (backend == BoardBackend::DENSE)
+    {
+        for (int i = 0; i < n; ++i)
+            if (isTileResident(moves[i].to)) materialize(chunkIndex(moves[i].to));
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        const Move& m = moves[i];
+
+        if (!isInside(m.from) || !isInside(m.to)) results[i] = MoveResult::INVALID;
+        else if ((slots[i] = readTile(m.from, TileLayer::ACTOR).slot) < 0) results[i] = MoveResult::NO_ENTITY;
+        else if (m.from == m.to) results[i] = MoveResult::MOVED;
+        else if (!isTileResident(m.to)) results[i] = MoveResult::OCCUPIED;
+        else {
+            states[i] = PENDING;
+            order.push_back(i);
+        }
+    }
+
+    // Keep one move per source tile and one per target tile, ties broken on tile keys.
+    auto dropDuplicates = [&](auto key, auto tieBreak) {
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return std::make_tuple(key(a), tieBreak(a), a) < std::make_tuple(key(b), tieBreak(b), b);
+        });
+        for (size_t k = 1; k < order.size(); ++k)
+        {
+            if (key(order[k]) == key(order[k - 1]))
+            {
+                states[order[k]] = DONE;
+                results[order[k]] = MoveResult::CONFLICT;
+            }
+        }
+        order.erase(std::remove_if(order.begin(), order.end(), [&](int i) { return states[i] == DONE; }), order.end());
+    };
+
+    auto fromKey = [&](int i) { return tileKey(moves[i].from); };
+    auto toKey = [&](int i) { return tileKey(moves[i].to); };
+    dropDuplicates(fromKey, toKey);
+    dropDuplicates(toKey, fromKey);
+
+    // order is now sorted by target. Sort by source to find the move leaving a target tile.
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return fromKey(a) < fromKey(b); });
+
+    for (int i : order)
+    {
+        if (getTerrainAt(moves[i].to) == Terrain::WALL) {
+            states[i] = BLOCKED;
+            continue;
+        }
+        if (readTile(moves[i].to, TileLayer::ACTOR).slot < 0) {
+            states[i] = MOVING;
+            continue;
+        }
+
+        auto it = std::lower_bound(order.begin(), order.end(), toKey(i),
+                                   [&](int j, std::uint32_t key) { return fromKey(j) < key; });
+        if (it != order.end() && fromKey(*it) == toKey(i))
+            dependsOn[i] = *it;
+        else
+            states[i] = BLOCKED;
+    }
+
+    // A move waiting on another one takes its outcome. A cycle of waiting moves is a rotation and succeeds.
+    for (int i : order)
+    {
+        int cur = i;
+        while (states[cur] == PENDING)
+        {
+            states[cur] = VISITING;
+            stack.push_back(cur);
+            cur = dependsOn[cur];
+        }
+
+        std::uint8_t outcome = (states[cur] == BLOCKED) ? BLOCKED : MOVING;
+        for (int j : stack) states[j] = outcome;
+        stack.clear();
+    }
+
+    // Lift every mover first, then place them, so chains and rotations never overlap.
+    for (int i : order)
+    {
+        if (states[i] == MOVING)
+            writeTile(moves[i].from, TileLayer::ACTOR, -1, Entities::EntityType::NONE);
+    }
+
+    for (int i : order)
+    {
+        if (states[i] != MOVING) {
+            results[i] = MoveResult::OCCUPIED;
+            continue;
         }
+
+        const EntityId id = entities[slots[i]];
+        Entities::EntityType type = registry.getComponents().types[id.index()];
+        writeTile(moves[i].to, TileLayer::ACTOR, slots[i], type);
+        entityPositions[slots[i]] = moves[i].to;
+        registry.getComponents().positions[id.index()] = moves[i].to;
+        journal.record({BoardChange::Kind::MOVE, type, moves[i].from, moves[i].to, entities[slots[i]]});
+        results[i] = MoveResult::MOVED;
     }
 }
 
-std::shared_ptr<Entities::IEntity> Core::Board::getEntityAt(Utils::Position pos) const
+int Core::Board::insertSlot(Entities::EntityType type)
 {
-    for (auto& e : entities)
-        if (e->getPos() == pos)
-            return e;
-    return nullptr;
+    const int t = static_cast<int>(type);
+
+    // Open a hole at the end and walk it down to the end of t's range by moving the
+    // first entry of each following range to that range's end.
+    int hole = static_cast<int>(entities.size());
+    entities.emplace_back();
+    entityPositions.emplace_back();
+    ++typeBegin[typeCount];
+
+    for (int k = typeCount - 1; k > t; --k)
+    {
+        int first = typeBegin[k];
+        if (first != hole) moveSlot(first, hole);
+        hole = first;
+        ++typeBegin[k];
+    }
+    return hole;
 }
 
-Entities::EntityType Core::Board::getEntityTypeAt(Utils::Position pos) const
+void Core::Board::removeSlot(int slot)
 {
-    auto e = getEntityAt(pos);
-    return e ? e->getType() : Entities::EntityType::NONE;
+    Utils::Position pos = entityPositions[slot].unpack();
+    const Entities::EntityType type = typeOfSlot(slot);
+    const int t = static_cast<int>(type);
+
+    writeTile(pos, layerOf(type), -1, Entities::EntityType::NONE);
+
+    // Fill the slot with the last entry of its range, then walk the hole up to the end
+    // of the vector by moving the last entry of each following range to its front.
+    int hole = typeBegin[t + 1] - 1;
+    if (slot != hole) moveSlot(hole, slot);
+
+    for (int k = t + 1; k < typeCount; ++k)
+    {
+        --typeBegin[k];
+        int last = typeBegin[k + 1] - 1;
+        if (last != hole) moveSlot(last, hole);
+        hole = last;
+    }
+
+    --typeBegin[typeCount];
+    entities.pop_back();
+    entityPositions.pop_back();
+}
+
+void Core::Board::moveSlot(int from, int to)
+{
+    entities[to] = entities[from];
+    entityPositions[to] = entityPositions[from];
+
+    Utils::Position pos = entityPositions[to].unpack();
+    const Entities::EntityType type = typeOfSlot(to);
+    writeTile(pos, layerOf(type), to, type);
 }
 
-bool Core::Board::isTileWalkable(Utils::Position pos) const
+Core::EntityId Core::Board::getEntityAt(Utils::Position pos, TileLayer layer) const
 {
-    auto type = getEntityTypeAt(pos);
-    return type == Entities::EntityType::NONE || type == Entities::EntityType::PLAYER
-    || type == Entities::EntityType::HEAL || type == Entities::EntityType::ITEM;
+    int slot = readTile(pos, layer).slot;
+    return slot >= 0 ? entities[slot] : EntityId{};
 }
 
-std::vector<std::shared_ptr<Entities::Enemy>> Core::Board::getEnemies() const
+Entities::EntityType Core::Board::getEntityTypeAt(Utils::Position pos, TileLayer layer) const
 {
-    std::vector<std::shared_ptr<Entities::Enemy>> enemies;
-    for (auto& e : entities)
+    return readTile(pos, layer).type;
+}
+
+bool Core::Board::isTileEmpty(Utils::Position pos) const
+{
+    return readTile(pos, TileLayer::ACTOR).slot < 0 && readTile(pos, TileLayer::ITEM).slot < 0
+        && getTerrainAt(pos) == Terrain::FLOOR;
+}
+
+Core::Terrain Core::Board::getTerrainAt(Utils::Position pos) const
+{
+    if (backend == BoardBackend::SPARSE)
     {
-        if (e->getType() == Entities::EntityType::ENEMY)
-            enemies.push_back(std::dynamic_pointer_cast<Entities::Enemy>(e));
+        const SpatialHash::Entry* entry = isInside(pos) ? sparseTerrain.find(pos) : nullptr;
+        return entry ? static_cast<Terrain>(entry->slot) : Terrain::FLOOR;
+    }
+
+    int chunk = chunkIndex(pos);
+    if (chunk < 0 || !chunks[chunk]) return Terrain::FLOOR;
+    return chunks[chunk]->terrain[localIndex(pos)];
+}
+
+void Core::Board::setTerrainAt(Utils::Position pos, Terrain terrain)
+{
+    if (!isInside(pos))
+    {
+        std::cerr << "Invalid Position: (" << pos.x << ", " << pos.y << ")" << std::endl;
+        return;
     }
-    return enemies;
+
+    journal.record({BoardChange::Kind::TERRAIN, Entities::EntityType::NONE, pos, pos, {}});
+
+    if (backend == BoardBackend::SPARSE)
+    {
+        if (terrain == Terrain::FLOOR) sparseTerrain.erase(pos);
+        else sparseTerrain.assign(pos, static_cast<int>(terrain), Entities::EntityType::NONE);
+        return;
+    }
+
+    setTerrain(*materialize(chunkIndex(pos)), pos, terrain);
+}
+
+void Core::Board::setTerrain(Chunk& chunk, Utils::Position pos, Terrain terrain)
+{
+    int tile = localIndex(pos);
+    chunk.wallCount += (terrain == Terrain::WALL) - (chunk.terrain[tile] == Terrain::WALL);
+    chunk.terrain[tile] = terrain;
+
+    std::uint32_t bit = 1u << (pos.y & (chunkSize - 1));
+    std::uint32_t& row = chunk.wallRows[pos.x & (chunkSize - 1)];
+    row = (terrain == Terrain::WALL) ? (row | bit) : (row & ~bit);
+    updateBlocked(chunk, pos);
+}
+
+void Core::Board::updateBlocked(Chunk& chunk, Utils::Position pos)
+{
+    int tile = localIndex(pos);
+    bool blocked = chunk.terrain[tile] == Terrain::WALL
+                || blocksMovement(chunk.types[static_cast<int>(TileLayer::ACTOR)][tile]);
+
+    std::uint32_t bit = 1u << (pos.y & (chunkSize - 1));
+    std::uint32_t& row = chunk.blockedRows[pos.x & (chunkSize - 1)];
+    row = blocked ? (row | bit) : (row & ~bit);
+}
+
+void Core::Board::setTile(Chunk& chunk, Utils::Position pos, TileLayer layer, int slot, Entities::EntityType type)
+{
+    const int l = static_cast<int>(layer);
+    int tile = localIndex(pos);
+    Entities::EntityType oldType = chunk.types[l][tile];
+
+    if (oldType != Entities::EntityType::NONE) {
+        --chunk.typeCounts[static_cast<int>(oldType)];
+        --chunk.entityCount;
+    }
+    if (type != Entities::EntityType::NONE) {
+        ++chunk.typeCounts[static_cast<int>(type)];
+        ++chunk.entityCount;
+    }
+
+    chunk.slots[l][tile] = slot;
+    chunk.types[l][tile] = type;
+
+    std::uint32_t bit = 1u << (pos.y & (chunkSize - 1));
+    std::uint32_t& row = chunk.occupiedRows[l][pos.x & (chunkSize - 1)];
+    row = (type != Entities::EntityType::NONE) ? (row | bit) : (row & ~bit);
+    if (layer == TileLayer::ACTOR) updateBlocked(chunk, pos);
+}
+
+bool Core::Board::isTileBlocked(Utils::Position pos) const
+{
+    if (backend == BoardBackend::SPARSE)
+        return !isInside(pos) || blocksMovement(readTile(pos, TileLayer::ACTOR).type) || getTerrainAt(pos) == Terrain::WALL;
+
+    int chunk = chunkIndex(pos);
+    if (chunk < 0) return true;
+    if (!chunks[chunk]) return chunkStates[chunk] == ChunkState::ON_DISK;
+
+    return (chunks[chunk]->blockedRows[pos.x & (chunkSize - 1)] >> (pos.y & (chunkSize - 1))) & 1u;
+}
+
+template <typename Grid>
+std::uint8_t Core::Board::walkableMask(const Grid& grid, Utils::Position pos) const
+{
+    const int lx = pos.x & (chunkSize - 1);
+    const int ly = pos.y & (chunkSize - 1);
+    const int chunk = chunkIndex(pos);
+
+    // Fast path: all four neighbours are in the same loaded chunk, read three row words.
+    if (backend == BoardBackend::DENSE && chunk >= 0 && chunks[chunk] && lx > 0 && lx < chunkSize - 1 && ly > 0 && ly < chunkSize - 1
+        && pos.x + 1 < grid.height() && pos.y + 1 < grid.width())
+    {
+        const std::uint32_t* rows = chunks[chunk]->blockedRows;
+        std::uint32_t blocked = ((rows[lx - 1] >> ly) & 1u) << Utils::Direction::UP
+                              | ((rows[lx + 1] >> ly) & 1u) << Utils::Direction::DOWN
+                              | ((rows[lx] >> (ly - 1)) & 1u) << Utils::Direction::LEFT
+                              | ((rows[lx] >> (ly + 1)) & 1u) << Utils::Direction::RIGHT;
+        return static_cast<std::uint8_t>(~blocked & 0xF);
+    }
+
+    std::uint8_t mask = 0;
+    for (auto dir : {Utils::Direction::UP, Utils::Direction::DOWN, Utils::Direction::LEFT, Utils::Direction::RIGHT})
+    {
+        // A step off a BOUNDED board lands on pos, which is never walkable for its occupant.
+        const Utils::Position next = grid.step(pos, dir);
+        if (next != pos && !isTileBlocked(next))
+            mask |= 1u << dir;
+    }
+    return mask;
+}
+
+std::uint8_t Core::Board::getWalkableNeighbours(Utils::Position pos) const
+{
+    return Utils::withGrid(boardSize, [&](const auto& grid) { return walkableMask(grid, pos); });
+}
+
+void Core::Board::getWalkableNeighbours(std::span<const Utils::Position> positions, std::span<std::uint8_t> masks) const
+{
+    const size_t count = std::min(positions.size(), masks.size());
+    Utils::withGrid(boardSize, [&](const auto& grid) {
+        for (size_t i = 0; i < count; ++i)
+            masks[i] = walkableMask(grid, positions[i]);
+    });
+}
+
+void Core::Board::touch(Utils::Position pos)
+{
+    int chunk = (pos.x >> chunkShift) * chunkCols + (pos.y >> chunkShift);
+    if (!isInside(pos) || snapshotDirty[chunk]) return;
+
+    snapshotDirty[chunk] = 1;
+    dirtyChunks.push_back(chunk);
+}
+
+std::shared_ptr<const Core::ChunkSnapshot> Core::Board::buildChunkSnapshot(int chunk) const
+{
+    if (backend == BoardBackend::DENSE && (!chunks[chunk] || chunks[chunk]->entityCount == 0))
+        return nullptr;
+
+    auto snap = std::allocate_shared<ChunkSnapshot>(TrackedAllocator<ChunkSnapshot, MemoryTag::BOARD>());
+
+    const int firstRow = (chunk / chunkCols) << chunkShift;
+    const int firstCol = (chunk % chunkCols) << chunkShift;
+    const int lastRow = std::min(firstRow + chunkSize, boardSize.height);
+    const int lastCol = std::min(firstCol + chunkSize, boardSize.width);
+
+    for (int x = firstRow; x < lastRow; ++x)
+    {
+        for (int y = firstCol; y < lastCol; ++y)
+        {
+            for (TileLayer layer : {TileLayer::ACTOR, TileLayer::ITEM})
+            {
+                TileInfo tile = readTile({x, y}, layer);
+                if (tile.slot < 0) continue;
+
+                const EntityId id = entities[tile.slot];
+                EntitySnapshot record{id, tile.type, {x, y}, registry.get(id)->getName()};
+
+                if (layer == TileLayer::ACTOR)
+                    record.stats = registry.getComponents().stats[id.index()];
+
+                snap->entities.push_back(std::move(record));
+            }
+        }
+    }
+
+    if (snap->entities.empty()) return nullptr;
+    return snap;
+}
+
+std::shared_ptr<const Core::BoardSnapshot> Core::Board::snapshot()
+{
+    for (int chunk : dirtyChunks)
+    {
+        snapshotCache[chunk] = buildChunkSnapshot(chunk);
+        snapshotDirty[chunk] = 0;
+    }
+    dirtyChunks.clear();
+
+    auto snap = std::allocate_shared<BoardSnapshot>(TrackedAllocator<BoardSnapshot, MemoryTag::BOARD>());
+    snap->boardSize = boardSize;
+    snap->chunkShift = chunkShift;
+    snap->chunkCols = chunkCols;
+    snap->tick = journal.getTick();
+
+    for (int chunk = 0; chunk < static_cast<int>(snapshotCache.size()); ++chunk)
+    {
+        if (snapshotCache[chunk])
+            snap->chunks.emplace_back(chunk, snapshotCache[chunk]);
+    }
+    return snap;
+}
+
+template <typename Visit>
+void Core::Board::forEachInWindow(Utils::Position center, int radius, Entities::EntityTypeMask typeMask, Visit&& visit) const
+{
+    // A window wider than the board covers each row/column once. On a BOUNDED board the
+    // window is clipped to the board, so the wraparound below never kicks in.
+    const bool wraps = boardSize.topology == Topology::WRAP;
+    int rows, cols, firstRow, firstCol;
+    if (wraps)
+    {
+        rows = std::min(2 * radius + 1, boardSize.height);
+        cols = std::min(2 * radius + 1, boardSize.width);
+        firstRow = ((center.x - radius) % boardSize.height + boardSize.height) % boardSize.height;
+        firstCol = ((center.y - radius) % boardSize.width + boardSize.width) % boardSize.width;
+    }
+    else
+    {
+        firstRow = std::max(0, center.x - radius);
+        firstCol = std::max(0, center.y - radius);
+        rows = std::min(boardSize.height - 1, center.x + radius) - firstRow + 1;
+        cols = std::min(boardSize.width - 1, center.y + radius) - firstCol + 1;
+        if (rows <= 0 || cols <= 0) return;
+    }
+
+    if (backend == BoardBackend::SPARSE)
+    {
+        size_t candidates = 0;
+        for (int t = 0; t < typeCount; ++t)
+            if (typeMask & Entities::typeMaskOf(static_cast<Entities::EntityType>(t)))
+                candidates += countOf(static_cast<Entities::EntityType>(t));
+
+        // Probe the window tile by tile, or filter the matching entities, whichever is less work.
+        if (static_cast<size_t>(rows) * cols <= candidates)
+        {
+            for (int l = 0; l < layerCount; ++l)
+            {
+                if (!(typeMask & typeMaskOf(static_cast<TileLayer>(l)))) continue;
+
+                for (int i = 0; i < rows; ++i)
+                    for (int j = 0; j < cols; ++j)
+                    {
+                        const SpatialHash::Entry* entry = sparseTiles[l].find({(firstRow + i) % boardSize.height, (firstCol + j) % boardSize.width});
+                        if (entry && (typeMask & Entities::typeMaskOf(entry->type)))
+                            visit(entry->slot);
+                    }
+            }
+            return;
+        }
+
+        for (int t = 0; t < typeCount; ++t)
+        {
+            if (!(typeMask & Entities::typeMaskOf(static_cast<Entities::EntityType>(t)))) continue;
+
+            for (int slot = typeBegin[t]; slot < typeBegin[t + 1]; ++slot)
+            {
+                const Utils::PackedPosition p = entityPositions[slot];
+                int dx = std::abs(p.x() - center.x);
+                int dy = std::abs(p.y() - center.y);
+                if (wraps)
+                {
+                    dx = std::min(dx, boardSize.height - dx);
+                    dy = std::min(dy, boardSize.width - dy);
+                }
+                if (dx <= radius && dy <= radius)
+                    visit(slot);
+            }
+        }
+        return;
+    }
+
+    for (int i = 0; i < rows; ++i)
+    {
+        const int x = (firstRow + i) % boardSize.height;
+        const int chunkRow = (x >> chunkShift) * chunkCols;
+
+        // Walk the columns in runs that stay inside one chunk, skipping chunks without a match.
+        int y = firstCol;
+        int remaining = cols;
+        while (remaining > 0)
+        {
+            const int chunkEnd = std::min(boardSize.width, ((y >> chunkShift) + 1) << chunkShift);
+            const int run = std::min(remaining, chunkEnd - y);
+            const Chunk* chunk = chunks[chunkRow + (y >> chunkShift)].get();
+
+            if (chunk && chunk->hasAny(typeMask))
+            {
+                const int lx = x & (chunkSize - 1);
+                const int ly = y & (chunkSize - 1);
+                const std::uint32_t runBits = (run == chunkSize ? ~0u : (1u << run) - 1) << ly;
+
+                // Only the occupied tiles of the run, read from the row mask of each layer.
+                for (int l = 0; l < layerCount; ++l)
+                {
+                    if (!(typeMask & typeMaskOf(static_cast<TileLayer>(l)))) continue;
+
+                    for (std::uint32_t bits = chunk->occupiedRows[l][lx] & runBits; bits; bits &= bits - 1)
+                    {
+                        int tile = (lx << chunkShift) | std::countr_zero(bits);
+                        if (typeMask & Entities::typeMaskOf(chunk->types[l][tile]))
+                            visit(chunk->slots[l][tile]);
+                    }
+                }
+            }
+
+            remaining -= run;
+            y = (y + run) % boardSize.width;
+        }
+    }
+}
+
+size_t Core::Board::queryRadius(Utils::Position center, int radius, Entities::EntityTypeMask typeMask,
+                                std::span<EntityId> out) const
+{
+    size_t count = 0;
+    forEachInWindow(center, radius, typeMask, [&](int slot) {
+        if (count < out.size()) out[count++] = entities[slot];
+    });
+    return count;
+}
+
+size_t Core::Board::queryNearest(Utils::Position center, int radius, Entities::EntityTypeMask typeMask,
+                                 std::span<EntityId> out) const
+{
+    size_t count = 0;
+    if (out.empty()) return 0;
+
+    // Insertion into the caller's buffer, which stays sorted by distance.
+    forEachInWindow(center, radius, typeMask, [&](int slot) {
+        const int d = distanceSquared(center, entityPositions[slot].unpack());
+
+        size_t i = count < out.size() ? count++ : out.size();
+        while (i > 0 && distanceSquared(center, registry.getComponents().positions[out[i - 1].index()]) > d)
+        {
+            if (i < out.size()) out[i] = out[i - 1];
+            --i;
+        }
+        if (i < out.size()) out[i] = entities[slot];
+    });
+    return count;
+}
+
+int Core::Board::distanceSquared(Utils::Position a, Utils::Position b) const
+{
+    if (boardSize.topology == Topology::BOUNDED)
+        return Utils::Grid<Topology::BOUNDED>(boardSize).distanceSquared(a, b);
+    return Utils::Grid<Topology::WRAP>(boardSize).distanceSquared(a, b);
+}
+
+std::span<const Core::EntityId> Core::Board::getEntitiesOfType(Entities::EntityType type) const
+{
+    if (type == Entities::EntityType::NONE) return {};
+
+    const int t = static_cast<int>(type);
+    return std::span<const EntityId>(entities).subspan(typeBegin[t], typeBegin[t + 1] - typeBegin[t]);
+}
+
+size_t Core::Board::countOf(Entities::EntityType type) const
+{
+    if (type == Entities::EntityType::NONE) return 0;
+
+    const int t = static_cast<int>(type);
+    return static_cast<size_t>(typeBegin[t + 1] - typeBegin[t]);
 }
 
-std::vector<std::shared_ptr<Entities::IEntity>> Core::Board::getEntities() const
+size_t Core::Board::totalCountOf(Entities::EntityType type) const
 {
-    return entities;
+    if (type == Entities::EntityType::NONE) return 0;
+    return countOf(type) + storedTotals[static_cast<int>(type)];
 }
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include "core/boardSnapshot.h"
+#include <algorithm>
+
+size_t Core::BoardSnapshot::entityCount() const
+{
+    size_t count = 0;
+    for (const auto& [index, chunk] : chunks)
+        count += chunk->entities.size();
+    return count;
+}
+
+const Core::EntitySnapshot* Core::BoardSnapshot::findAt(Utils::Position pos, TileLayer layer) const
+{
+    const int index = (pos.x >> chunkShift) * chunkCols + (pos.y >> chunkShift);
+
+    auto it = std::lower_bound(chunks.begin(), chunks.end(), index,
+                               [](const auto& entry, int i) { return entry.first < i; });
+    if (it == chunks.end() || it->first != index) return nullptr;
+
+    for (const auto& e : it->second->entities)
+        if (e.pos == pos && layerOf(e.type) == layer) return &e;
+    return nullptr;
+}
\ No newline at end of file
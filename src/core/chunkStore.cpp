@@ -0,0 +1,187 @@
+#include "core/chunkStore.h"
+#include "entities/enemy.h"
+#include "entities/healItem.h"
+#include "entities/swordItem.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+namespace {
+
+    template <typename T>
+    void write(std::ostream& out, const T& value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T read(std::istream& in)
+    {
+        T value{};
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return value;
+    }
+
+    void writeString(std::ostream& out, const std::string& s)
+    {
+        write<std::uint32_t>(out, static_cast<std::uint32_t>(s.size()));
+        out.write(s.data(), s.size());
+    }
+
+    std::string readString(std::istream& in)
+    {
+        std::string s(read<std::uint32_t>(in), '\0');
+        in.read(s.data(), s.size());
+        return s;
+    }
+
+    void writeStats(std::ostream& out, const Entities::Stats& stats)
+    {
+        write(out, stats.healthPoint);
+        write(out, stats.attackPoint);
+        write(out, stats.defensePoint);
+        write(out, stats.xp);
+        write(out, stats.level);
+        write(out, stats.maxHp);
+    }
+
+    Entities::Stats readStats(std::istream& in)
+    {
+        auto hp = read<Entities::Fixed>(in);
+        auto attack = read<Entities::Fixed>(in);
+        auto defense = read<Entities::Fixed>(in);
+
+        Entities::Stats stats(hp, attack, defense);
+        stats.xp = read<int>(in);
+        stats.level = read<int>(in);
+        stats.maxHp = read<Entities::Fixed>(in);
+        return stats;
+    }
+}
+
+Core::ChunkStore::ChunkStore(const std::string& root)
+{
+    std::error_code ec;
+    const std::filesystem::path parent = root.empty() ? std::filesystem::temp_directory_path(ec) : std::filesystem::path(root);
+    std::filesystem::create_directories(parent, ec);
+
+    // Random, plus a counter for stores made in the same process.
+    static std::atomic<unsigned> stores{0};
+    std::random_device rd;
+    for (int attempt = 0; attempt < 16; ++attempt)
+    {
+        const auto candidate = parent / ("gamerpg-chunks-" + std::to_string(rd()) + "-" + std::to_string(stores++));
+        if (std::filesystem::create_directory(candidate, ec))
+        {
+            directory = candidate.string();
+            return;
+        }
+    }
+    std::cerr << "Failed to create a chunk directory under " << parent.string() << ", chunks stay in memory" << std::endl;
+}
+
+Core::ChunkStore::~ChunkStore()
+{
+    std::error_code ec;
+    if (!directory.empty()) std::filesystem::remove_all(directory, ec);
+}
+
+std::string Core::ChunkStore::pathOf(int chunk) const
+{
+    return directory + "/chunk_" + std::to_string(chunk) + ".bin";
+}
+
+bool Core::ChunkStore::save(int chunk, const std::vector<Entities::IEntity*>& entities, std::span<const Terrain> terrain)
+{
+    if (directory.empty()) return false;
+
+    std::ofstream out(pathOf(chunk), std::ios::binary);
+    if (!out)
+    {
+        std::cerr << "Failed to write chunk file: " << pathOf(chunk) << std::endl;
+        return false;
+    }
+
+    write<std::uint32_t>(out, static_cast<std::uint32_t>(entities.size()));
+
+    for (const auto& e : entities)
+    {
+        write(out, e->getType());
+        write(out, e->getPos().x);
+        write(out, e->getPos().y);
+        writeString(out, e->getName());
+
+        switch (e->getType())
+        {
+            case Entities::EntityType::ENEMY:
+                writeStats(out, static_cast<Entities::Enemy*>(e)->getStats());
+                break;
+            case Entities::EntityType::ITEM:
+                write(out, static_cast<Entities::SwordItem*>(e)->getDamage());
+                break;
+            case Entities::EntityType::HEAL:
+                write(out, static_cast<Entities::HealItem*>(e)->getAmmount());
+                break;
+            default:
+                break;
+        }
+    }
+
+    write<std::uint32_t>(out, static_cast<std::uint32_t>(terrain.size()));
+    out.write(reinterpret_cast<const char*>(terrain.data()), terrain.size_bytes());
+
+    return static_cast<bool>(out);
+}
+
+std::vector<Core::EntityId> Core::ChunkStore::load(int chunk, EntityRegistry& registry, std::span<Terrain> terrain)
+{
+    std::vector<EntityId> entities;
+
+    std::ifstream in(pathOf(chunk), std::ios::binary);
+    if (!in) return entities;
+
+    auto count = read<std::uint32_t>(in);
+    entities.reserve(count);
+
+    for (std::uint32_t i = 0; i < count && in; ++i)
+    {
+        auto type = read<Entities::EntityType>(in);
+        Utils::Position pos;
+        pos.x = read<int>(in);
+        pos.y = read<int>(in);
+        auto name = Utils::intern(readString(in));
+
+        switch (type)
+        {
+            case Entities::EntityType::ENEMY:
+                entities.push_back(registry.create<Entities::Enemy>(name, readStats(in), pos));
+                break;
+            case Entities::EntityType::ITEM:
+                entities.push_back(registry.create<Entities::SwordItem>(name, read<Entities::Fixed>(in), pos));
+                break;
+            case Entities::EntityType::HEAL:
+                entities.push_back(registry.create<Entities::HealItem>(name, read<Entities::Fixed>(in), pos));
+                break;
+            default:
+                break;
+        }
+    }
+
+    auto tiles = read<std::uint32_t>(in);
+    if (in && tiles > 0)
+    {
+        if (tiles == terrain.size())
+            in.read(reinterpret_cast<char*>(terrain.data()), terrain.size_bytes());
+        else
+            std::cerr << "Chunk file " << pathOf(chunk) << " has " << tiles << " terrain tiles, expected " << terrain.size() << std::endl;
+    }
+
+    in.close();
+    std::error_code ec;
+    std::filesystem::remove(pathOf(chunk), ec);
+
+    return entities;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "core/commandBuffer.h"
+#include "core/board.h"
+#include "utils/util.h"
+#include <algorithm>
+
+void Core::CommandBuffer::spawn(EntityId entity, Utils::Position pos)
+{
+    if (!entity) return;
+    spawns.push_back({entity, pos});
+}
+
+void Core::CommandBuffer::despawn(EntityId entity)
+{
+    if (!entity) return;
+    despawns.push_back(entity);
+}
+
+void Core::CommandBuffer::apply(Board& board)
+{
+    auto& registry = board.getRegistry();
+
+    // Index order frees neighbouring rows together, and drops an entity despawned twice.
+    std::sort(despawns.begin(), despawns.end(),
+              [](EntityId a, EntityId b) { return a.index() < b.index(); });
+    despawns.erase(std::unique(despawns.begin(), despawns.end()), despawns.end());
+
+    for (auto id : despawns)
+    {
+        auto entity = registry.get(id);
+        if (!entity) continue;
+
+        const Utils::Position pos = entity->getPos();
+        const TileLayer layer = layerOf(entity->getType());
+        if (board.getEntityAt(pos, layer) == id)
+            board.deleteEntityAt(pos, layer);
+        else
+            registry.destroy(id);
+    }
+
+    for (const auto& s : spawns)
+    {
+        if (!registry.isAlive(s.entity)) continue;
+
+        Utils::Position pos = s.pos;
+        if ((!board.isTileEmpty(pos) || !board.isTileResident(pos)) && !Utils::generateRandomPosition(board, pos))
+        {
+            // Nowhere left to put it: the spawn is dropped.
+            registry.destroy(s.entity);
+            continue;
+        }
+
+        board.setEntityAt(pos, s.entity);
+    }
+
+    despawns.clear();
+    spawns.clear();
+}
\ No newline at end of file
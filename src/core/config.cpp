@@ -0,0 +1,56 @@
+#include "core/config.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+Core::GameConfig Core::GameConfig::fromArgs(int argc, char* argv[])
+{
+    GameConfig config;
+
+    auto readSize = [&](int index, int fallback) {
+        if (index >= argc) return fallback;
+
+        int value = std::atoi(argv[index]);
+        int clamped = std::clamp(value, minBoardSize, maxBoardSize);
+        if (clamped != value)
+            std::cerr << "Board size " << argv[index] << " out of range, using " << clamped << std::endl;
+        return clamped;
+    };
+
+    config.board.width = readSize(1, config.board.width);
+    config.board.height = readSize(2, config.board.width);
+
+    if (argc > 3)
+    {
+        std::string backend = argv[3];
+        if (backend == "sparse") config.boardBackend = BoardBackend::SPARSE;
+        else if (backend != "dense") std::cerr << "Unknown board backend " << backend << ", using dense" << std::endl;
+    }
+
+    if (argc > 4)
+    {
+        long capKiB = std::atol(argv[4]);
+        if (capKiB > 0)
+        {
+            config.memory.hardCaps = true;
+            config.memory.entityBytes = static_cast<size_t>(capKiB) * 1024;
+        }
+        else if (std::string(argv[4]) != "0") std::cerr << "Invalid entity memory cap " << argv[4] << ", running without caps" << std::endl;
+    }
+
+    if (argc > 5)
+    {
+        std::string topology = argv[5];
+        if (topology == "bounded") config.board.topology = Topology::BOUNDED;
+        else if (topology != "wrap") std::cerr << "Unknown board topology " << topology << ", using wrap" << std::endl;
+    }
+
+    if (argc > 6)
+    {
+        int threads = std::atoi(argv[6]);
+        if (threads >= 0) config.enemyThreads = threads;
+        else std::cerr << "Invalid enemy thread count " << argv[6] << ", using " << config.enemyThreads << std::endl;
+    }
+
+    return config;
+}
\ No newline at end of file
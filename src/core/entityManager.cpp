@@ -1,106 +1,205 @@
 #include "core/entityManager.h"
+#include "utils/grid.h"
 
-void Core::EntityManager::spawnEnemy(Core::Board& board,std::shared_ptr<Entities::Player> player)
+Core::EntityManager::EntityManager(int threads) : workers(threads), pathFinders(workers.size()) {}
+
+template <typename T>
+bool Core::EntityManager::canSpawn(int count)
 {
-    int enemyHp = this->playerBasedHp(player);
-    double enemyAttack = this->playerBasedAttack(player);
-    double enemyDefense = this->playerBasedDefense(player);
+    // Estimate: the object and its component row. Slab and vector growth come in bigger steps.
+    const size_t bytes = count * (sizeof(T) + ComponentStore::rowBytes);
+    const bool capped = memory().wouldExceed(MemoryTag::ENTITIES, bytes);
+
+    if (capped && !spawnCapped)
+        std::cerr << "Entity memory cap reached, spawns are skipped" << std::endl;
+    spawnCapped = capped;
+    return !capped;
+}
 
-    Utils::Position defaultPos = {0,0}; 
+void Core::EntityManager::spawnEnemy(Core::Board& board, CommandBuffer& commands, EntityId player)
+{
+    if (!canSpawn<Entities::Enemy>(3)) return;
 
-    auto enemy1 = std::make_shared<Entities::Enemy>(Utils::generateRandomName(),Entities::Stats(enemyHp,enemyAttack,enemyDefense),defaultPos);
-    auto enemy2 = std::make_shared<Entities::Enemy>(Utils::generateRandomName(),Entities::Stats(enemyHp,enemyAttack,enemyDefense),defaultPos);
-    auto enemy3 = std::make_shared<Entities::Enemy>(Utils::generateRandomName(),Entities::Stats(enemyHp,enemyAttack,enemyDefense),defaultPos);
+    auto& registry = board.getRegistry();
+    const Entities::Stats playerStats = registry.get<Entities::Player>(player)->getStats();
 
-    board.setEntityAt(Utils::generateRandomPosition(board), enemy1);
-    board.setEntityAt(Utils::generateRandomPosition(board), enemy2);
-    board.setEntityAt(Utils::generateRandomPosition(board), enemy3);
+    int enemyHp = this->playerBasedHp(playerStats);
+    Entities::Fixed enemyAttack = this->playerBasedAttack(playerStats);
+    Entities::Fixed enemyDefense = this->playerBasedDefense(playerStats);
 
+    Utils::Position defaultPos = {0,0}; 
+
+    for (int i = 0; i < 3; ++i)
+    {
+        // No free tile around the player: skip the rest of the wave.
+        Utils::Position pos;
+        if (!Utils::generateRandomPosition(board, pos)) return;
+
+        auto enemy = registry.create<Entities::Enemy>(Utils::generateRandomName(),Entities::Stats(enemyHp,enemyAttack,enemyDefense),defaultPos);
+        commands.spawn(enemy, pos);
+    }
 }
 
 void Core::EntityManager::initEntities(Core::Game& g)
 {
-    int boardSize = 19;
+    const Core::Size boardSize = g.board->getBoardSizes();
 
-    g.player = std::make_shared<Entities::Player>(Utils::Position{0,0});
-    g.board->setEntityAt({boardSize/2,boardSize/2},g.player);
+    g.player = g.registry.create<Entities::Player>(Utils::Position{0,0});
+    g.board->setEntityAt({boardSize.height/2,boardSize.width/2},g.player);
+    g.board->updateResidency(g.getPlayer()->getPos());
 
-    auto sword = std::make_shared<Entities::SwordItem>("Sword",5,Utils::Position{0,0});
-    Utils::Position randomPos = Utils::generateRandomPosition(*g.board);
-    g.board->setEntityAt(Utils::Position{randomPos.x,randomPos.y},sword);
+    Utils::Position randomPos;
+    if (Utils::generateRandomPosition(*g.board, randomPos))
+    {
+        auto sword = g.registry.create<Entities::SwordItem>(Utils::intern("Sword"),5,Utils::Position{0,0});
+        g.board->setEntityAt(Utils::Position{randomPos.x,randomPos.y},sword);
+    }
 
-    spawnEnemy(*g.board,g.player);
-    spawnHeal(*g.board,g.player);
+    spawnEnemy(*g.board,g.commands,g.player);
+    spawnHeal(*g.board,g.commands,g.player);
 }
 
-void Core::EntityManager::spawnHeal(Core::Board& board,std::shared_ptr<Entities::Player> player)
+void Core::EntityManager::spawnHeal(Core::Board& board, CommandBuffer& commands, EntityId player)
 {
 
-    if(Utils::getHealInBoard(board).empty()){
-        int playerHp = player->getStats().healthPoint;
-        int playerMaxHp = player->getStats().maxHp;
+    if(board.totalCountOf(Entities::EntityType::HEAL) == 0){
+        auto& registry = board.getRegistry();
+        const Entities::Stats playerStats = registry.get<Entities::Player>(player)->getStats();
+        Entities::Fixed playerHp = playerStats.healthPoint;
+        Entities::Fixed playerMaxHp = playerStats.maxHp;
     
-        if (playerHp <= playerMaxHp/2){
-            double amount = playerBasedHealAmmount(player);
-            auto potionHeal = std::make_shared<Entities::HealItem>("Heal", amount, Utils::Position{0,0});
-            board.setEntityAt(Utils::generateRandomPosition(board),potionHeal);
+        Utils::Position pos;
+        if (playerHp <= playerMaxHp / 2 && canSpawn<Entities::HealItem>(1) && Utils::generateRandomPosition(board, pos)){
+            Entities::Fixed amount = playerBasedHealAmmount(playerStats);
+            auto potionHeal = registry.create<Entities::HealItem>(Utils::intern("Heal"), amount, Utils::Position{0,0});
+            commands.spawn(potionHeal, pos);
         }
     }
 }
 
 void Core::EntityManager::enemyAlgorithm(Core::Game& g)
 {
-    auto enemyList = g.board->getEnemies();
+    auto& board = *g.board;
+    Entities::Player* player = g.getPlayer();
 
-    if(!enemyList.empty()){
+    if(board.enemyCount() != 0){
         Uint32 currentTime = SDL_GetTicks();
+        const Utils::Position playerPos = player->getPos();
+        auto& c = g.registry.getComponents();
+
+        // Streams the type, timer and position arrays to pick the enemies due to act.
+        dueEnemies.clear();
+        bool anyChasing = false;
+        Utils::withGrid(board.getBoardSizes(), [&](const auto& grid) {
+            for (std::uint32_t i = 0; i < c.size(); ++i)
+            {
+                if (c.types[i] != Entities::EntityType::ENEMY) continue;
+                if (static_cast<std::int32_t>(currentTime - c.nextActionTimes[i]) <= 0) continue;
+                // Spawns still queued in the command buffer are not on the board yet.
+                if (board.getEntityAt(c.positions[i], TileLayer::ACTOR) != g.registry.idAt(i)) continue;
+
+                // calculateDistance truncated the root, so "<= 5" held up to 35.
+                const bool chasing = grid.distanceSquared(c.positions[i], playerPos) < 6 * 6;
+                dueEnemies.push_back({i, chasing});
+                anyChasing |= chasing;
+                c.nextActionTimes[i] = currentTime + enemyMoveDelay;
+            }
+        });
+        if (dueEnemies.empty()) return;
 
-        for (const auto& e : enemyList)
-        {
-            if (currentTime - e->lastMoveTime > 200)
+        // Moved with the player only when someone chases, a goal step costs up to a rebuild.
+        if (anyChasing) flowField.setGoal(board, playerPos);
+
+        const std::uint64_t tick = ++enemyTicks;
+        intents.resize(dueEnemies.size());
+        workers.forEach(dueEnemies.size(), [&](int worker, size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k)
             {
-                if (Utils::calculateDistance(e,g.player) <= 5)
-                    e->chase(g,g.player);
-                else
-                    e->patrol(g);
+                const EntityId id = g.registry.idAt(dueEnemies[k].index);
+                auto e = static_cast<const Entities::Enemy*>(g.registry.get(id));
+                const std::uint32_t roll = Utils::mix(tick, id.value);
 
-                e->lastMoveTime = currentTime;
+                intents[k] = dueEnemies[k].chasing ? e->chase(g, *player, pathFinders[worker], roll)
+                                                   : e->patrol(g, roll);
             }
+        });
+
+        resolveIntents(g);
+    }
+}
+
+void Core::EntityManager::resolveIntents(Core::Game& g)
+{
+    auto& board = *g.board;
+    auto& c = g.registry.getComponents();
+    EntityId fighter;
+
+    for (std::uint8_t round = 0; round < 2; ++round)
+    {
+        moves.clear();
+        movers.clear();
+
+        for (std::uint32_t k = 0; k < dueEnemies.size(); ++k)
+        {
+            auto& intent = intents[k];
+            if (intent.count <= round) continue;
+
+            const Utils::Position from = c.positions[dueEnemies[k].index];
+            const Utils::Position to = Utils::getDirection(from.x, from.y, intent.steps[round], board.getBoardSizes());
+
+            if (board.getEntityTypeAt(to, TileLayer::ACTOR) == Entities::EntityType::PLAYER)
+            {
+                if (!fighter) fighter = g.registry.idAt(dueEnemies[k].index);
+                intent.count = round;
+                continue;
+            }
+
+            moves.push_back({from, to});
+            movers.push_back(k);
         }
+        if (moves.empty()) break;
+
+        moveResults.resize(moves.size());
+        board.applyMoves(moves, moveResults);
+
+        for (size_t i = 0; i < moves.size(); ++i)
+            if (moveResults[i] != MoveResult::MOVED) intents[movers[i]].count = round;
     }
+
+    if (fighter) Systems::StartFight(g, fighter);
 }
 
-int Core::EntityManager::playerBasedHp(std::shared_ptr<Entities::Player> player)
+int Core::EntityManager::playerBasedHp(const Entities::Stats& playerStats)
 {
     int baseHp = 10;
-    int lvl = player->getStats().level;
-    return baseHp + static_cast<int>((lvl - 1) * 5 * 1.25);
+    int lvl = playerStats.level;
+    return baseHp + (lvl - 1) * 25 / 4;
 }
 
 
-double Core::EntityManager::playerBasedAttack(std::shared_ptr<Entities::Player> player)
+Entities::Fixed Core::EntityManager::playerBasedAttack(const Entities::Stats& playerStats)
 {
-    double attack = player->getStats().attackPoint;
-    int lvl = player->getStats().level;
+    Entities::Fixed attack = playerStats.attackPoint;
+    int lvl = playerStats.level;
     if (lvl > 1){
-        return attack * 0.55;
+        return attack * Entities::Fixed::ratio(55, 100);
     }
-    return 2.0;
+    return 2;
 }
 
 
-double Core::EntityManager::playerBasedDefense(std::shared_ptr<Entities::Player> player)
+Entities::Fixed Core::EntityManager::playerBasedDefense(const Entities::Stats& playerStats)
 {
-    double defense = player->getStats().defensePoint;
-    int lvl = player->getStats().level;
+    Entities::Fixed defense = playerStats.defensePoint;
+    int lvl = playerStats.level;
     if (lvl > 1){
-        return defense * 1.25;
+        return defense * Entities::Fixed::ratio(5, 4);
     }
-    return 2.0;
+    return 2;
 }
 
 
-double Core::EntityManager::playerBasedHealAmmount(std::shared_ptr<Entities::Player> player)
+Entities::Fixed Core::EntityManager::playerBasedHealAmmount(const Entities::Stats& playerStats)
 {
-    return player->getStats().maxHp / 1.5;
+    return playerStats.maxHp * Entities::Fixed::ratio(2, 3);
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "core/entityRegistry.h"
+#include <iostream>
+
+Core::EntityRegistry::~EntityRegistry()
+{
+    for (size_t i = 0; i < objects.size(); ++i)
+        if (objects[i]) owners[i]->release(objects[i]);
+}
+
+size_t Core::EntityRegistry::nextPoolKind()
+{
+    static size_t count = 0;
+    return count++;
+}
+
+Core::EntityId Core::EntityRegistry::add(Entities::IEntity* entity, PoolBase& pool)
+{
+    std::uint32_t index;
+    if (!freeIndices.empty())
+    {
+        index = freeIndices.back();
+        freeIndices.pop_back();
+    }
+    else
+    {
+        if (objects.size() > EntityId::indexMask)
+        {
+            std::cerr << "Entity registry is full" << std::endl;
+            pool.release(entity);
+            return {};
+        }
+
+        index = static_cast<std::uint32_t>(objects.size());
+        objects.push_back(nullptr);
+        owners.push_back(nullptr);
+        generations.push_back(1);
+
+        components.types.push_back(Entities::EntityType::NONE);
+        components.positions.emplace_back();
+        components.stats.emplace_back(0, 0, 0);
+        components.derived.emplace_back();
+        components.nextActionTimes.push_back(0);
+    }
+
+    EntityId id = EntityId::make(index, generations[index]);
+
+    components.types[index] = entity->getType();
+    components.positions[index] = entity->spawnPos;
+    components.stats[index] = entity->spawnStats;
+    components.derived[index] = Entities::deriveStats(entity->spawnStats);
+    components.nextActionTimes[index] = 0;
+
+    entity->id = id;
+    entity->components = &components;
+    objects[index] = entity;
+    owners[index] = &pool;
+    ++liveCount;
+    return id;
+}
+
+void Core::EntityRegistry::destroy(EntityId id)
+{
+    if (!isAlive(id)) return;
+
+    const std::uint32_t index = id.index();
+    owners[index]->release(objects[index]);
+    objects[index] = nullptr;
+    owners[index] = nullptr;
+    components.types[index] = Entities::EntityType::NONE;
+    --liveCount;
+
+    // Generation 0 is skipped so no live handle is ever the null handle.
+    generations[index] = (generations[index] + 1) & EntityId::generationMask;
+    if (generations[index] == 0) generations[index] = 1;
+
+    freeIndices.push_back(index);
+}
+
+bool Core::EntityRegistry::isAlive(EntityId id) const
+{
+    const std::uint32_t index = id.index();
+    return id && index < objects.size() && generations[index] == id.generation() && objects[index];
+}
+
+Entities::IEntity* Core::EntityRegistry::get(EntityId id) const
+{
+    return isAlive(id) ? objects[id.index()] : nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "core/frameArena.h"
+#include <algorithm>
+
+Core::FrameArena::FrameArena(size_t capacity) : block(capacity) {}
+
+void* Core::FrameArena::allocate(size_t bytes, size_t align)
+{
+    size_t start = (offset + align - 1) & ~(align - 1);
+    if (start + bytes <= block.size())
+    {
+        offset = start + bytes;
+        return block.data() + start;
+    }
+
+    // Operator new aligns to max_align_t, enough for everything the frame stores.
+    overflow.emplace_back(bytes);
+    spilled += bytes;
+    return overflow.back().data();
+}
+
+void Core::FrameArena::reset()
+{
+    if (!overflow.empty())
+    {
+        const size_t needed = offset + spilled;
+        overflow.clear();
+        block = Block(std::max(needed + needed / 2, block.size() * 2));
+        spilled = 0;
+    }
+    offset = 0;
+}
\ No newline at end of file
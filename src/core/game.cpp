@@ -2,10 +2,14 @@
 
 void Core::Game::initGame()
 {
-    if (!WindowRenderer.initWindow(900,608)) return;
+    if (!WindowRenderer.initWindow(config.windowWidth(), config.windowHeight())) return;
     if (!WindowRenderer.initRenderer()) return;
     if (!WindowRenderer.initFonts()) return;
 
+    memory().setHardCaps(config.memory.hardCaps);
+    memory().setCap(MemoryTag::ENTITIES, config.memory.entityBytes);
+    memory().setCap(MemoryTag::TEXT, config.memory.textBytes);
+
     textureManager.init(WindowRenderer.renderer);
     textureManager.load("player", "../assets/images/Miku_forgor.png");
     textureManager.load("enemy", "../assets/images/sinje.jpg");
@@ -13,15 +17,28 @@ void Core::Game::initGame()
     textureManager.load("bow", "../assets/images/Minecraft_bow.jpg");
     textureManager.load("heal", "../assets/images/Heal_potion.png");
     
-    board = std::make_unique<Board>();
-    entityManager = std::make_unique<EntityManager>();
+    board = std::make_unique<Board>(registry, config.board, config.streaming, config.boardBackend);
+    board->getJournal().setEnabled(true);
+    entityManager = std::make_unique<EntityManager>(config.enemyThreads);
 
     entityManager->initEntities(*this);
+    commands.apply(*board);
+
+}
+
+Entities::Player* Core::Game::getPlayer() const
+{
+    return registry.get<Entities::Player>(player);
+}
 
+Entities::Enemy* Core::Game::getCurrentEnemy() const
+{
+    return registry.get<Entities::Enemy>(currentEnemy);
 }
 
 void Core::Game::quit()
 {
+    view.clearTextCache();
     WindowRenderer.quit();
 }
 
@@ -33,8 +50,14 @@ void Core::Game::run()
 
     while (running)
     {
+        // Walls placed or streamed in last frame, before the journal forgets them.
+        entityManager->flowField.applyChanges(*board, board->getJournal().getChanges());
+        board->getJournal().nextTick();
+        frameArena.reset();
+
         handleEvents(running);
         update(running);
+        commands.apply(*board);
         render();
 
         SDL_Delay(16); // ~60 FPS
@@ -60,11 +83,12 @@ void Core::Game::handleEvents(bool& running)
                     break;
 
                 case GameState::GAMEPLAY:
-                    if      (Systems::is_key_pressed(SDL_SCANCODE_W)) player->move(*this, Utils::Direction::UP);
-                    else if (Systems::is_key_pressed(SDL_SCANCODE_S)) player->move(*this, Utils::Direction::DOWN);
-                    else if (Systems::is_key_pressed(SDL_SCANCODE_A)) player->move(*this, Utils::Direction::LEFT);
-                    else if (Systems::is_key_pressed(SDL_SCANCODE_D)) player->move(*this, Utils::Direction::RIGHT);
+                    if      (Systems::is_key_pressed(SDL_SCANCODE_W)) getPlayer()->move(*this, Utils::Direction::UP);
+                    else if (Systems::is_key_pressed(SDL_SCANCODE_S)) getPlayer()->move(*this, Utils::Direction::DOWN);
+                    else if (Systems::is_key_pressed(SDL_SCANCODE_A)) getPlayer()->move(*this, Utils::Direction::LEFT);
+                    else if (Systems::is_key_pressed(SDL_SCANCODE_D)) getPlayer()->move(*this, Utils::Direction::RIGHT);
                     else if (Systems::is_key_pressed(SDL_SCANCODE_RETURN)) state = GameState::PAUSE;
+                    else if (Systems::is_key_pressed(SDL_SCANCODE_M)) memory().report(std::cout);
                     break;
 
                 case GameState::FIGHT:
@@ -87,7 +111,9 @@ void Core::Game::handleEvents(bool& running)
 
 void Core::Game::update(bool& running)
 {
-    if (player->getStats().healthPoint <= 0)
+    Entities::Player* p = getPlayer();
+
+    if (p->getStats().healthPoint <= 0)
     {
         state = GameState::GAMEOVER;
         return;
@@ -95,6 +121,8 @@ void Core::Game::update(bool& running)
 
     if (state == GameState::GAMEPLAY)
     {
+        board->updateResidency(p->getPos());
+
         Uint32 currentTime = SDL_GetTicks();
 
         if (currentTime - lastEnemyUpdate > enemyUpdateInterval)
@@ -103,27 +131,37 @@ void Core::Game::update(bool& running)
             lastEnemyUpdate = currentTime;
         }
 
-        if (board->getEnemies().empty())
-            entityManager->spawnEnemy(*board, player);
+        // Enemies streamed out to disk still count, they come back with their chunk.
+        if (board->totalCountOf(Entities::EntityType::ENEMY) == 0)
+            entityManager->spawnEnemy(*board, commands, player);
 
-        entityManager->spawnHeal(*board, player);
+        entityManager->spawnHeal(*board, commands, player);
     }
     else if (state == GameState::FIGHT)
     {
-        if (currentTurn == Systems::Turn::ENEMY && !isCombatOver)
+        // Removals are deferred to the end of the tick, the handle only goes stale
+        // if the enemy was removed some other way.
+        Entities::Enemy* enemy = getCurrentEnemy();
+
+        if (enemy && currentTurn == Systems::Turn::ENEMY && !isCombatOver)
         {
             Systems::handleMobTurn(*this, currentEnemy);
             currentTurn = Systems::Turn::PLAYER;
         }
 
-        if (isCombatOver || currentEnemy->getStats().healthPoint <= 0)
+        // Combat changes stats without moving anything, flag both for the next snapshot.
+        board->touch(p->getPos());
+        if (enemy) board->touch(enemy->getPos());
+
+        if (!enemy || isCombatOver || enemy->getStats().healthPoint <= 0)
         {
-            if (currentEnemy->getStats().healthPoint <= 0) {
-                player->getStats().gainXp(currentEnemy->getStats().level * 3);
-                board->deleteEntityAt(currentEnemy->getPos());
+            if (enemy && enemy->getStats().healthPoint <= 0) {
+                if (p->getStats().gainXp(enemy->getStats().level * 3))
+                    p->refreshDerived(registry);
+                commands.despawn(currentEnemy);
             }
             state = GameState::GAMEPLAY;
-            currentEnemy = nullptr;
+            currentEnemy = {};
         }
     }
 }
@@ -148,7 +186,7 @@ void Core::Game::render()
             break;
 
         case GameState::FIGHT:
-            if (currentEnemy) {
+            if (getCurrentEnemy()) {
                 view.drawCombat(*this, currentEnemy, currentTurn, selectedIndex, inventorySelected);
             }
             break;
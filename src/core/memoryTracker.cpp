@@ -0,0 +1,73 @@
+#include "core/memoryTracker.h"
+
+void Core::MemoryTracker::onAllocate(MemoryTag tag, size_t bytes)
+{
+    Counter& c = counters[static_cast<size_t>(tag)];
+    const size_t now = c.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    c.allocations.fetch_add(1, std::memory_order_relaxed);
+
+    size_t peak = c.peak.load(std::memory_order_relaxed);
+    while (now > peak && !c.peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+}
+
+void Core::MemoryTracker::onFree(MemoryTag tag, size_t bytes)
+{
+    counters[static_cast<size_t>(tag)].bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+Core::MemoryStats Core::MemoryTracker::getStats(MemoryTag tag) const
+{
+    const Counter& c = counters[static_cast<size_t>(tag)];
+    MemoryStats stats;
+    stats.bytes = c.bytes.load(std::memory_order_relaxed);
+    stats.peak = c.peak.load(std::memory_order_relaxed);
+    stats.allocations = c.allocations.load(std::memory_order_relaxed);
+    stats.cap = c.cap.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void Core::MemoryTracker::setCap(MemoryTag tag, size_t bytes)
+{
+    counters[static_cast<size_t>(tag)].cap.store(bytes, std::memory_order_relaxed);
+}
+
+bool Core::MemoryTracker::wouldExceed(MemoryTag tag, size_t extra) const
+{
+    if (!hardCaps) return false;
+
+    const MemoryStats stats = getStats(tag);
+    return stats.cap != 0 && stats.bytes + extra > stats.cap;
+}
+
+void Core::MemoryTracker::report(std::ostream& out) const
+{
+    for (size_t i = 0; i < counters.size(); ++i)
+    {
+        const MemoryStats stats = getStats(static_cast<MemoryTag>(i));
+        out << nameOf(static_cast<MemoryTag>(i)) << ": " << stats.bytes / 1024 << " KiB"
+            << " (peak " << stats.peak / 1024 << " KiB";
+        if (stats.cap) out << ", cap " << stats.cap / 1024 << " KiB";
+        out << ", " << stats.allocations << " allocations)" << std::endl;
+    }
+}
+
+const char* Core::MemoryTracker::nameOf(MemoryTag tag)
+{
+    switch (tag)
+    {
+        case MemoryTag::BOARD: return "board";
+        case MemoryTag::ENTITIES: return "entities";
+        case MemoryTag::TEXTURES: return "textures";
+        case MemoryTag::TEXT: return "text";
+        case MemoryTag::INVENTORY: return "inventory";
+        case MemoryTag::FRAME: return "frame";
+        case MemoryTag::AI: return "ai";
+        default: return "unknown";
+    }
+}
+
+Core::MemoryTracker& Core::memory()
+{
+    static MemoryTracker tracker;
+    return tracker;
+}
\ No newline at end of file
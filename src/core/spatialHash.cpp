@@ -0,0 +1,93 @@
+#include "core/spatialHash.h"
+
+Core::SpatialHash::SpatialHash()
+{
+    table.resize(16);
+    mask = table.size() - 1;
+}
+
+size_t Core::SpatialHash::probeStart(std::uint32_t key) const
+{
+    // Fibonacci hashing spreads neighbouring tiles over the table.
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+const Core::SpatialHash::Entry* Core::SpatialHash::find(Utils::Position pos) const
+{
+    const std::uint32_t key = keyOf(pos);
+
+    for (size_t i = probeStart(key); ; i = (i + 1) & mask)
+    {
+        if (table[i].key == key) return &table[i];
+        if (table[i].key == emptyKey) return nullptr;
+    }
+}
+
+Core::SpatialHash::Entry* Core::SpatialHash::find(Utils::Position pos)
+{
+    return const_cast<Entry*>(static_cast<const SpatialHash*>(this)->find(pos));
+}
+
+void Core::SpatialHash::assign(Utils::Position pos, int slot, Entities::EntityType type)
+{
+    // Keep the load factor at or below 1/2 so probe chains stay short.
+    if ((count + 1) * 2 > table.size()) grow();
+
+    const std::uint32_t key = keyOf(pos);
+    size_t i = probeStart(key);
+
+    while (table[i].key != emptyKey && table[i].key != key)
+        i = (i + 1) & mask;
+
+    if (table[i].key == emptyKey) ++count;
+    table[i] = {key, slot, type};
+}
+
+void Core::SpatialHash::erase(Utils::Position pos)
+{
+    const std::uint32_t key = keyOf(pos);
+    size_t i = probeStart(key);
+
+    while (table[i].key != key)
+    {
+        if (table[i].key == emptyKey) return;
+        i = (i + 1) & mask;
+    }
+
+    // Backward-shift deletion: pull later entries of the chain into the hole, no tombstones.
+    size_t hole = i;
+    for (size_t j = (hole + 1) & mask; table[j].key != emptyKey; j = (j + 1) & mask)
+    {
+        size_t home = probeStart(table[j].key);
+        bool canMove = (hole <= j) ? (home <= hole || home > j) : (home <= hole && home > j);
+
+        if (canMove)
+        {
+            table[hole] = table[j];
+            hole = j;
+        }
+    }
+
+    table[hole] = Entry{};
+    --count;
+}
+
+void Core::SpatialHash::grow()
+{
+    auto old = std::move(table);
+    table.assign(old.size() * 2, Entry{});
+    mask = table.size() - 1;
+    count = 0;
+
+    for (const Entry& e : old)
+    {
+        if (e.key == emptyKey) continue;
+
+        size_t i = probeStart(e.key);
+        while (table[i].key != emptyKey)
+            i = (i + 1) & mask;
+
+        table[i] = e;
+        ++count;
+    }
+}
\ No newline at end of file
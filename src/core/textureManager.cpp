@@ -1,7 +1,18 @@
 #include "core/textureManager.h"
+#include "core/memoryTracker.h"
 
 namespace Core {
 
+    namespace {
+        /// GPU-side size estimate, SDL does not report the real one.
+        size_t textureBytes(SDL_Texture* tex)
+        {
+            int w = 0, h = 0;
+            SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
+            return static_cast<size_t>(w) * h * 4;
+        }
+    }
+
     bool TextureManager::init(SDL_Renderer* r)
     {
         renderer = r;
@@ -19,7 +30,15 @@ namespace Core {
             return false;
         }
 
-        textures[id] = tex;
+        auto& slot = textures[id];
+        if (slot)
+        {
+            memory().onFree(MemoryTag::TEXTURES, textureBytes(slot));
+            SDL_DestroyTexture(slot);
+        }
+
+        slot = tex;
+        memory().onAllocate(MemoryTag::TEXTURES, textureBytes(tex));
         return true;
     }
 
@@ -37,6 +56,7 @@ namespace Core {
     {
         for (auto& [id, tex] : textures)
         {
+            memory().onFree(MemoryTag::TEXTURES, textureBytes(tex));
             SDL_DestroyTexture(tex);
         }
 
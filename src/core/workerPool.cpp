@@ -0,0 +1,67 @@
+#include "core/workerPool.h"
+#include <algorithm>
+
+Core::WorkerPool::WorkerPool(int threads)
+    : threadCount(threads > 0 ? threads : std::max(1, static_cast<int>(std::thread::hardware_concurrency())))
+{
+    this->threads.reserve(threadCount - 1);
+    for (int worker = 1; worker < threadCount; ++worker)
+        this->threads.emplace_back(&WorkerPool::workerLoop, this, worker);
+}
+
+Core::WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (auto& thread : threads)
+        thread.join();
+}
+
+void Core::WorkerPool::run(Call call, void* context)
+{
+    if (threadCount == 1)
+    {
+        call(context, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = call;
+        jobContext = context;
+        pending = threadCount - 1;
+        ++generation;
+    }
+    wake.notify_all();
+
+    call(context, 0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&] { return pending == 0; });
+}
+
+void Core::WorkerPool::workerLoop(int worker)
+{
+    std::uint64_t done = 0;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        wake.wait(lock, [&] { return stopping || generation != done; });
+        if (stopping) return;
+
+        done = generation;
+        Call call = job;
+        void* context = jobContext;
+
+        lock.unlock();
+        call(context, worker);
+        lock.lock();
+
+        if (--pending == 0) finished.notify_one();
+    }
+}
\ No newline at end of file
@@ -1,15 +1,14 @@
 #include "entities/enemy.h"
+#include <bit>
 
 
-void Entities::Enemy::setHp(const int amount)
+void Entities::Enemy::setHp(Fixed amount)
 {
-    stats.healthPoint = (amount < 0) ? 0 : amount;
+    statsComponent().healthPoint = (amount < 0) ? Fixed(0) : amount;
 }
 
-void Entities::Enemy::render(const Core::Game& g)
+void Entities::Enemy::render(const Core::Game& g, const SDL_Rect& rect)
 {
-    SDL_Rect rect = { pos.y * 32, pos.x * 32, 32, 32 };
-
     SDL_Texture* tex = g.textureManager.get("enemy");
 
     if (tex)
@@ -21,70 +20,74 @@ void Entities::Enemy::render(const Core::Game& g)
     }
 }
 
-void Entities::Enemy::attack(std::shared_ptr<Player> p)
+void Entities::Enemy::attack(Player& p)
 {
-    double attackAmount = getStats().attackPoint;
-    double finalDamage;
+    Fixed attackAmount = getDerived().attack;
+    Fixed finalDamage;
 
-    if (p->isPlayerProtecting()) {
-        finalDamage = p->damageWithProtect(attackAmount);
+    if (p.isPlayerProtecting()) {
+        finalDamage = p.damageWithProtect(attackAmount);
     } else {
-        double defense = p->getStats().defensePoint;
-        finalDamage = attackAmount * (100.0 / (100.0 + defense));
+        finalDamage = attackAmount * p.getDerived().mitigation;
     }
 
-    double playerHp = p->getStats().healthPoint;
-    playerHp -= finalDamage;
+    Fixed playerHp = p.getStats().healthPoint - finalDamage;
     if (playerHp < 0) playerHp = 0;
 
-    p->getStats().healthPoint = playerHp;
+    p.getStats().healthPoint = playerHp;
 }
 
-void Entities::Enemy::chase(Core::Game& g,std::shared_ptr<Entities::Player> p)
+Entities::MoveIntent Entities::Enemy::chase(const Core::Game& g, const Player& p, Systems::PathFinder& finder, std::uint32_t roll) const
 {
-    auto e_pos = pos;
-    auto playerPos = p->getPos();
-    
-    if (e_pos.x < playerPos.x)
-        move(g, Utils::Direction::DOWN);
-    else if (e_pos.x > playerPos.x)
-        move(g, Utils::Direction::UP);
-
-    if (e_pos.y < playerPos.y)
-        move(g, Utils::Direction::RIGHT);
-    else if (e_pos.y > playerPos.y)
-        move(g, Utils::Direction::LEFT);
+    const auto& field = g.entityManager->flowField;
+    MoveIntent intent;
+    Utils::Position pos = getPos();
+
+    // Up to two steps a turn, the pace of the diagonal moves the chase used to make.
+    while (intent.count < 2)
+    {
+        Utils::Direction dir;
+        if (!field.stepFrom(pos, dir) || !canEnter(g, pos, dir))
+        {
+            // The field ignores the other actors, only a blocked first step needs a search.
+            if (intent.count == 0) return followPath(g, p, finder, roll);
+            break;
+        }
+
+        intent.steps[intent.count++] = dir;
+        pos = Utils::getDirection(pos.x, pos.y, dir, g.board->getBoardSizes());
+    }
+    return intent;
 }
 
-void Entities::Enemy::patrol(Core::Game& g)
+Entities::MoveIntent Entities::Enemy::followPath(const Core::Game& g, const Player& p, Systems::PathFinder& finder, std::uint32_t roll) const
 {
-    Utils::Direction dir = Utils::getRandDir();
-    move(g,dir);
+    if (!finder.findPath(*g.board, getPos(), p.getPos(), chaseSearchRadius) || finder.getPath().empty())
+        return patrol(g, roll);
+
+    MoveIntent intent;
+    for (auto dir : finder.getPath().first(std::min<size_t>(2, finder.getPath().size())))
+        intent.steps[intent.count++] = dir;
+    return intent;
 }
 
-void Entities::Enemy::setPos(const Utils::Position pos)
+bool Entities::Enemy::canEnter(const Core::Game& g, Utils::Position pos, Utils::Direction dir) const
 {
-    this->pos = pos;
+    auto target = Utils::getDirection(pos.x, pos.y, dir, g.board->getBoardSizes());
+    return g.board->isTileWalkable(target)
+        || g.board->getEntityTypeAt(target, Core::TileLayer::ACTOR) == Entities::EntityType::PLAYER;
 }
 
-void Entities::Enemy::move(Core::Game& game,Utils::Direction dir)
+Entities::MoveIntent Entities::Enemy::patrol(const Core::Game& g, std::uint32_t roll) const
 {
-    auto currentPos = this->pos;
-    auto targetPos = Utils::getDirection(currentPos.x,currentPos.y,dir);
-    auto& board = game.board;
-
-    if (!board->isTileWalkable(targetPos)) return;
+    MoveIntent intent;
+    std::uint8_t walkable = g.board->getWalkableNeighbours(getPos());
+    if (walkable == 0) return intent;
 
-    auto targetEntity = board->getEntityAt(targetPos);
-
-    if (targetEntity && targetEntity->getType() == Entities::EntityType::PLAYER)
-    {
-        Systems::StartFight(game, shared_from_this());
-        return;
-    }
-
-    board->setEntityAt(targetPos, shared_from_this());
-    board->deleteEntityAt(currentPos);
-    setPos(targetPos);
-}
+    // The (roll % count)-th walkable direction.
+    for (int skip = roll % std::popcount(walkable); skip > 0; --skip)
+        walkable &= walkable - 1;
 
+    intent.steps[intent.count++] = static_cast<Utils::Direction>(std::countr_zero(walkable));
+    return intent;
+}
\ No newline at end of file
@@ -1,9 +1,7 @@
 #include "entities/healItem.h"
 
-void Entities::HealItem::render(const Core::Game& g)
+void Entities::HealItem::render(const Core::Game& g, const SDL_Rect& rect)
 {
-    SDL_Rect rect = { pos.y * 32, pos.x * 32, 32, 32 };
-
     SDL_Texture* tex = g.textureManager.get("heal");
 
     if (tex)
@@ -1,46 +1,57 @@
 #include "entities/player.h"
+#include "entities/swordItem.h"
 
-void Entities::Player::setPos(Utils::Position p)
+void Entities::Player::attack(Enemy& e)
 {
-    this->pos = p;
+    Fixed damage = getDerived().attack * e.getDerived().mitigation;
+
+    if (e.getStats().healthPoint > 0)
+    {
+        e.setHp(e.getStats().healthPoint - damage);
+    }
 }
 
-void Entities::Player::attack(std::shared_ptr<Enemy> e)
+void Entities::Player::heal(Fixed amount)
 {
-    double EnemyDefense = e->getStats().defensePoint;
-    double damage = stats.attackPoint * (100.0 / (100.0 + EnemyDefense));
+    getStats().healthPoint += amount;
+}
 
-    if (e->getStats().healthPoint > 0)
+void Entities::Player::refreshDerived(const Core::EntityRegistry& registry)
+{
+    Fixed attackBonus = 0;
+    for (auto id : inventory.getItems())
     {
-        e->setHp(e->getStats().healthPoint - damage);
+        if (auto sword = registry.get<SwordItem>(id))
+            attackBonus += sword->getDamage();
     }
-}
 
-void Entities::Player::heal(int amount)
-{
-    this->stats.healthPoint += amount;
+    derivedComponent() = deriveStats(getStats(), attackBonus);
 }
 
-void Entities::Player::collect(Core::Board&  b, Utils::Position pos)
+void Entities::Player::collect(Core::Game& game, Utils::Position pos)
 {
-    auto item = std::dynamic_pointer_cast<Entities::Item>(b.getEntityAt(pos));
-    if (!item) return;
+    auto& b = *game.board;
+    auto item = b.getRegistry().get<Entities::Item>(b.getEntityAt(pos, Core::TileLayer::ITEM));
 
     if (!item) {
         std::cerr << "Entity is not an Item" << std::endl;
         return;
     }
-    inventory.addItem(item);
-    b.deleteEntityAt(pos);
-    
     std::cout << "Item " << item->getName() << " collected" << std::endl;
+
+    // Off the board, the item now belongs to the inventory (or is lost when it is full).
+    Core::EntityId id = b.takeEntityAt(pos, Core::TileLayer::ITEM);
+    if (inventory.addItem(id))
+        refreshDerived(b.getRegistry());
+    else
+        game.commands.despawn(id);
 }
 
 bool Entities::Player::run(const int rand1, const int rand2)
 {
 
-    auto hp = stats.healthPoint;
-    auto maxhp = stats.maxHp;
+    auto hp = getStats().healthPoint;
+    auto maxhp = getStats().maxHp;
 
     if (hp == maxhp){
         return true;
@@ -64,51 +75,33 @@ bool Entities::Player::run(const int rand1, const int rand2)
 
 void Entities::Player::move(Core::Game& game, Utils::Direction dir)
 {
-    auto currentPos = this->pos;
-    auto targetPos = Utils::getDirection(currentPos.x, currentPos.y, dir);
+    auto currentPos = getPos();
+    auto targetPos = Utils::getDirection(currentPos.x, currentPos.y, dir, game.board->getBoardSizes());
     auto& board = game.board;
 
+    // Enemies and walls block the way, items lie on their own layer under the player.
     if (!board->isTileWalkable(targetPos)) return;
+    if (board->moveEntity(currentPos, targetPos) != Core::MoveResult::MOVED) return;
 
-    auto targetEntity = board->getEntityAt(targetPos);
-
-    if (!targetEntity) {
-        board->setEntityAt(targetPos, shared_from_this());
-        board->deleteEntityAt(currentPos);
-        setPos(targetPos);
-        return;
-    }
-
-    switch (targetEntity->getType())
+    switch (board->getEntityTypeAt(targetPos, Core::TileLayer::ITEM))
     {
         case Entities::EntityType::ITEM:
-            collect(*board, targetPos);
-            board->setEntityAt(targetPos, shared_from_this());
-            board->deleteEntityAt(currentPos);
-            setPos(targetPos);
+            collect(game, targetPos);
             break;
 
         case Entities::EntityType::HEAL:
-            Utils::HealPlayerOnItem(shared_from_this(), *board, targetPos);
-            board->setEntityAt(targetPos, shared_from_this());
-            board->deleteEntityAt(currentPos);
-            setPos(targetPos);
+            Utils::HealPlayerOnItem(*this, *board, targetPos);
+            // Off the board now, freed at the end of the tick.
+            game.commands.despawn(board->takeEntityAt(targetPos, Core::TileLayer::ITEM));
             break;
 
-        case Entities::EntityType::ENEMY: {
-            auto mob = std::dynamic_pointer_cast<Entities::Enemy>(targetEntity);
-            Systems::StartFight(game, mob);
-            break;
-        }
         default:
             break;
     }
 }
 
-void Entities::Player::render(const Core::Game& g)
+void Entities::Player::render(const Core::Game& g, const SDL_Rect& rect)
 {
-    SDL_Rect rect = { pos.y * 32, pos.x * 32, 32, 32 };
-
     SDL_Texture* tex = g.textureManager.get("player");
 
     if (tex)
@@ -120,33 +113,23 @@ void Entities::Player::render(const Core::Game& g)
     }
 }
 
-double Entities::Player::damageWithProtect(int amount)
+Entities::Fixed Entities::Player::damageWithProtect(Fixed amount)
 {
     if (!isPlayerProtecting()){
         return 0;
     }
-    double damageReductionFactor = 0.5; // 50% of shield protection
-    double newAttackAmount = amount * damageReductionFactor;
+    Fixed damageReductionFactor = Fixed::ratio(1, 2); // 50% of shield protection
+    Fixed newAttackAmount = amount * damageReductionFactor;
 
     return newAttackAmount;
 }
 
-std::shared_ptr<Entities::Enemy> Entities::Player::getNearEnemy(Core::Board& b)
+Core::EntityId Entities::Player::getNearEnemy(Core::Board& b)
 {
-    auto playerPos = pos;
-
-	for (int x = playerPos.x - 2; x <= playerPos.x + 2; ++x) {
-		for (int y = playerPos.y - 2; y <= playerPos.y + 2; ++y) {
-			if (x >= 0 && x < b.getBoardSizes().boardSize && y >= 0 && y < b.getBoardSizes().boardSize) {
-				auto enemy = b.getEntityAt({x,y});
-				if (enemy && enemy->getType() == EntityType::ENEMY) {
-					return std::dynamic_pointer_cast<Entities::Enemy>(enemy);
-				}
-			}
-		}
-	}
-	return nullptr;
-}
-
+    Core::EntityId nearest[1];
 
+    if (b.queryNearest(getPos(), 2, typeMaskOf(EntityType::ENEMY), nearest) == 0)
+        return {};
 
+    return nearest[0];
+}
\ No newline at end of file
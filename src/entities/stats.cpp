@@ -1,12 +1,15 @@
 #include "entities/stats.h"
 
-void Entities::Stats::gainXp(int amount)
+bool Entities::Stats::gainXp(int amount)
 {
     if (amount > 0)
     {
+        const int before = level;
         xp += amount;
         checkLvlUp();
+        return level != before;
     }
+    return false;
 }
 
 void Entities::Stats::checkLvlUp()
@@ -18,7 +21,7 @@ void Entities::Stats::checkLvlUp()
         maxHp += 5;
         healthPoint = maxHp;
         attackPoint += 2;
-        defensePoint += 0.5;
+        defensePoint += Fixed::ratio(1, 2);
         std::cout << "Level Up !" << std::endl;
 
         threshold = level * (2 * level);
@@ -29,4 +32,13 @@ int Entities::Stats::getXpToNxtLvl()
 {
     int threshold = level * 10;
     return threshold - xp;
+}
+
+Entities::DerivedStats Entities::deriveStats(const Stats& base, Fixed attackBonus)
+{
+    DerivedStats d;
+    d.attack = base.attackPoint + attackBonus;
+    d.defense = base.defensePoint;
+    d.mitigation = Fixed(100) / (Fixed(100) + d.defense);
+    return d;
 }
\ No newline at end of file
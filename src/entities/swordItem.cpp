@@ -1,9 +1,7 @@
 #include "entities/swordItem.h"
 
-void Entities::SwordItem::render(const Core::Game& g)
+void Entities::SwordItem::render(const Core::Game& g, const SDL_Rect& rect)
 {
-    SDL_Rect rect = { pos.y * 32, pos.x * 32, 32, 32 };
-
     SDL_Texture* tex = g.textureManager.get("sword");
 
     if (tex)
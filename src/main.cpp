@@ -7,9 +7,10 @@ using namespace Core;
 /**
  * Main function
  */
-int main() {
+int main(int argc, char* argv[]) {
 
   Core::Game g;
+  g.config = Core::GameConfig::fromArgs(argc, argv);
   g.initGame();
   g.run();
   g.quit();
@@ -4,13 +4,15 @@
 
 void Systems::handlePlayerTurn(Core::Game &game,
                                Turn &turn,
-                               std::shared_ptr<Entities::Enemy> enemy,
+                               Core::EntityId mob,
                                int &selectedIndex,
                                bool &inventorySelected,
                                bool &isCombatOver)
 {
 
     const Uint8 *keys = SDL_GetKeyboardState(NULL);
+    auto enemy = game.registry.get<Entities::Enemy>(mob);
+    if (!enemy) return;
 
     {
         if (keys[SDL_SCANCODE_RIGHT])
@@ -21,13 +23,13 @@ void Systems::handlePlayerTurn(Core::Game &game,
 
         if (keys[SDL_SCANCODE_RETURN])
         {
-            auto player = game.player;
+            auto player = game.getPlayer();
             std::string choice = Utils::options[selectedIndex];
 
             if (choice == "Attack")
             {
                 inventorySelected = false;
-                player->attack(enemy);
+                player->attack(*enemy);
             }
             else if (choice == "Protect")
             {
@@ -45,7 +47,7 @@ void Systems::handlePlayerTurn(Core::Game &game,
                 {
                     std::cout << "Player tried to run..." << std::endl;
                     isCombatOver = true;
-                    game.board->deleteEntityAt(enemy->getPos());
+                    game.commands.despawn(mob);
                 }
                 else
                 {
@@ -59,15 +61,22 @@ void Systems::handlePlayerTurn(Core::Game &game,
     }
 }
 
-void Systems::handleMobTurn(Core::Game &game, std::shared_ptr<Entities::Enemy> enemy)
+void Systems::handleMobTurn(Core::Game &game, Core::EntityId mob)
 {
-    enemy->attack(game.player);
+    auto enemy = game.registry.get<Entities::Enemy>(mob);
+    if (enemy) enemy->attack(*game.getPlayer());
 }
 
-void Systems::StartFight(Core::Game &game, std::shared_ptr<Entities::Enemy> enemy)
+void Systems::StartFight(Core::Game &game, Core::EntityId mob)
 {
+    auto enemy = game.registry.get<Entities::Enemy>(mob);
+    if (!enemy) {
+        std::cerr << "Combat started against an invalid enemy" << std::endl;
+        return;
+    }
+
     game.state = Core::GameState::FIGHT;
-    game.currentEnemy = enemy;
+    game.currentEnemy = mob;
     game.currentTurn = Turn::PLAYER;
     game.isCombatOver = false;
 
@@ -0,0 +1,247 @@
+#include "systems/flowField.h"
+#include "core/board.h"
+#include <algorithm>
+#include <type_traits>
+
+namespace {
+
+    constexpr Utils::Direction directions[] = {Utils::Direction::UP, Utils::Direction::DOWN, Utils::Direction::LEFT, Utils::Direction::RIGHT};
+}
+
+Systems::FlowField::FlowField(int _radius) : radius(_radius) {}
+
+int Systems::FlowField::indexOf(Utils::Position pos) const
+{
+    if (goalTile < 0) return -1;
+    if (boardSize.topology == Core::Topology::BOUNDED)
+        return window.indexOf(Utils::Grid<Core::Topology::BOUNDED>(boardSize), pos);
+    return window.indexOf(Utils::Grid<Core::Topology::WRAP>(boardSize), pos);
+}
+
+bool Systems::FlowField::stepFrom(Utils::Position pos, Utils::Direction& dir) const
+{
+    const int tile = indexOf(pos);
+    if (tile < 0 || steps[tile] == noStep) return false;
+
+    dir = static_cast<Utils::Direction>(steps[tile]);
+    return true;
+}
+
+int Systems::FlowField::distanceFrom(Utils::Position pos) const
+{
+    const int tile = indexOf(pos);
+    return (tile < 0 || distances[tile] >= unreachable) ? -1 : distances[tile];
+}
+
+void Systems::FlowField::setGoal(const Core::Board& board, Utils::Position goal)
+{
+    const Core::Size size = board.getBoardSizes();
+
+    Utils::withGrid(size, [&](const auto& grid) {
+        if (!grid.contains(goal)) return;
+
+        // Per-axis distance from the window center, across the edges on a WRAP board.
+        auto away = [&](int a, int b, int n) {
+            int d = std::abs(a - b);
+            if constexpr (std::remove_cvref_t<decltype(grid)>::topology == Core::Topology::WRAP) d = std::min(d, n - d);
+            return d;
+        };
+
+        const bool sameBoard = size.width == boardSize.width && size.height == boardSize.height && size.topology == boardSize.topology;
+        if (goalTile < 0 || !sameBoard || away(goal.x, anchor.x, grid.height()) > radius / 2 || away(goal.y, anchor.y, grid.width()) > radius / 2)
+        {
+            rebuild(board, grid, goal);
+            return;
+        }
+
+        const int tile = window.indexOf(grid, goal);
+        if (tile == goalTile) return;
+
+        const int previous = goalTile;
+        goalTile = tile;
+        estimates[goalTile] = 0;
+        push(goalTile);
+        updateTile(previous);
+        repair();
+    });
+}
+
+void Systems::FlowField::applyChanges(const Core::Board& board, std::span<const Core::BoardChange> changes)
+{
+    if (goalTile < 0) return;
+
+    Utils::withGrid(boardSize, [&](const auto& grid) {
+        bool any = false;
+        for (const auto& change : changes)
+        {
+            if (change.kind != Core::BoardChange::Kind::TERRAIN) continue;
+
+            const int tile = window.indexOf(grid, change.to);
+            if (tile < 0) continue;
+
+            const std::uint8_t wall = board.getTerrainAt(change.to) == Core::Terrain::WALL;
+            if (walls[tile] == wall) continue;
+
+            walls[tile] = wall;
+            updateTile(tile);
+            any = true;
+        }
+
+        if (any) repair();
+    });
+}
+
+template <typename Grid>
+void Systems::FlowField::rebuild(const Core::Board& board, const Grid& grid, Utils::Position goal)
+{
+    boardSize = board.getBoardSizes();
+    anchor = goal;
+    window = Utils::GridWindow::around(grid, goal, radius);
+
+    const size_t tiles = static_cast<size_t>(window.size());
+    distances.assign(tiles, unreachable);
+    estimates.assign(tiles, unreachable);
+    steps.assign(tiles, noStep);
+    changedFlags.assign(tiles, 0);
+    queuedKeys.assign(tiles, noTile);
+    nextQueued.resize(tiles);
+    previousQueued.resize(tiles);
+    // No way is longer than the window has tiles.
+    buckets.assign(tiles + 1, noTile);
+    lowestBucket = buckets.size();
+    queued = 0;
+
+    walls.resize(tiles);
+    neighbours.resize(tiles);
+    for (int tile = 0; tile < window.size(); ++tile)
+    {
+        const Utils::Position pos = window.positionOf(grid, tile);
+        walls[tile] = board.getTerrainAt(pos) == Core::Terrain::WALL;
+        for (auto dir : directions)
+        {
+            const Utils::Position next = grid.step(pos, dir);
+            neighbours[tile][dir] = next == pos ? noTile : window.indexOf(grid, next);
+        }
+    }
+
+    goalTile = window.indexOf(grid, goal);
+    estimates[goalTile] = 0;
+    push(goalTile);
+    repair();
+}
+
+void Systems::FlowField::push(int tile)
+{
+    const int key = std::min(distances[tile], estimates[tile]);
+    if (queuedKeys[tile] == key) return;
+    if (queuedKeys[tile] != noTile) unlink(tile);
+
+    queuedKeys[tile] = key;
+    previousQueued[tile] = noTile;
+    nextQueued[tile] = buckets[key];
+    if (buckets[key] != noTile) previousQueued[buckets[key]] = tile;
+    buckets[key] = tile;
+
+    lowestBucket = std::min(lowestBucket, static_cast<size_t>(key));
+    ++queued;
+}
+
+void Systems::FlowField::unlink(int tile)
+{
+    const int previous = previousQueued[tile];
+    const int next = nextQueued[tile];
+    if (previous != noTile) nextQueued[previous] = next;
+    else buckets[queuedKeys[tile]] = next;
+    if (next != noTile) previousQueued[next] = previous;
+
+    queuedKeys[tile] = noTile;
+    --queued;
+}
+
+void Systems::FlowField::markChanged(int tile)
+{
+    if (changedFlags[tile]) return;
+    changedFlags[tile] = 1;
+    changed.push_back(tile);
+}
+
+void Systems::FlowField::updateTile(int tile)
+{
+    if (tile != goalTile)
+    {
+        int best = unreachable;
+        if (!walls[tile])
+        {
+            for (int n : neighbours[tile])
+                if (n != noTile) best = std::min(best, distances[n] + 1);
+        }
+        estimates[tile] = std::min(best, unreachable);
+    }
+
+    if (distances[tile] != estimates[tile]) push(tile);
+    else if (queuedKeys[tile] != noTile) unlink(tile);
+}
+
+void Systems::FlowField::repair()
+{
+    while (queued > 0)
+    {
+        while (buckets[lowestBucket] == noTile) ++lowestBucket;
+        const int tile = buckets[lowestBucket];
+        unlink(tile);
+
+        markChanged(tile);
+        if (distances[tile] > estimates[tile])
+        {
+            distances[tile] = estimates[tile];
+        }
+        else
+        {
+            // The tile lost the way its distance came from: forget it and let the neighbours
+            // offer a new one.
+            distances[tile] = unreachable;
+            updateTile(tile);
+        }
+
+        for (int n : neighbours[tile])
+            if (n != noTile) updateTile(n);
+    }
+    lowestBucket = buckets.size();
+
+    // A step only changes on a tile whose distance or a neighbour's distance changed. When
+    // that is most of the window, as after a goal step in the open, one pass over it is cheaper.
+    if (changed.size() * 5 >= steps.size())
+    {
+        for (int tile = 0; tile < static_cast<int>(steps.size()); ++tile)
+            refreshStep(tile);
+    }
+    else
+    {
+        for (int tile : changed)
+        {
+            refreshStep(tile);
+            for (int n : neighbours[tile])
+                if (n != noTile) refreshStep(n);
+        }
+    }
+    for (int tile : changed) changedFlags[tile] = 0;
+    lastRepairCount = changed.size();
+    changed.clear();
+}
+
+void Systems::FlowField::refreshStep(int tile)
+{
+    std::uint8_t step = noStep;
+    int best = distances[tile];
+
+    // First direction in UP, DOWN, LEFT, RIGHT order among the closest neighbours.
+    if (tile != goalTile && best < unreachable)
+    {
+        for (auto dir : directions)
+        {
+            const int n = neighbours[tile][dir];
+            if (n != noTile && distances[n] < best) { best = distances[n]; step = dir; }
+        }
+    }
+    steps[tile] = step;
+}
\ No newline at end of file
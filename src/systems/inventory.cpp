@@ -15,31 +15,39 @@ size_t Systems::Inventory::getSize() const
     return items.size();
 }
 
-void Systems::Inventory::addItem(std::shared_ptr<Entities::Item> item)
+bool Systems::Inventory::addItem(Core::EntityId item)
 {
-    if (!item)
+    if (!item) {
         std::cerr << "Item is null" << std::endl;
+        return false;
+    }
 
     if (items.size() >= InventorySize)
     {
         std::cout << "Inventory is full !" << "\n";
-        return;
+        return false;
     }
     
     items.push_back(item);
+    return true;
 }
 
-void Systems::Inventory::removeItem(const std::string& name)
+Core::EntityId Systems::Inventory::removeItem(Core::EntityId item)
 {
     for (auto it = items.begin(); it != items.end(); ++it) {
-        if ((*it)->getName() == name) {
+        if (*it == item) {
             items.erase(it);
-            return;
+            return item;
         }
     }
+    return {};
 }
 
-void Systems::Inventory::pop()
+Core::EntityId Systems::Inventory::pop()
 {
-    if (!items.empty()) items.pop_back();
+    if (items.empty()) return {};
+
+    Core::EntityId item = items.back();
+    items.pop_back();
+    return item;
 }
\ No newline at end of file
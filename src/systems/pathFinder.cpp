@@ -0,0 +1,118 @@
+#include "systems/pathFinder.h"
+#include "core/board.h"
+#include "utils/grid.h"
+#include <algorithm>
+
+namespace {
+
+    Utils::Direction opposite(Utils::Direction dir)
+    {
+        // UP/DOWN and LEFT/RIGHT differ in the low bit.
+        return static_cast<Utils::Direction>(dir ^ 1);
+    }
+}
+
+bool Systems::PathFinder::findPath(const Core::Board& board, Utils::Position from, Utils::Position to, int radius)
+{
+    return Utils::withGrid(board.getBoardSizes(), [&](const auto& grid) { return search(board, grid, from, to, radius); });
+}
+
+void Systems::PathFinder::nextQuery(size_t tiles)
+{
+    if (stamps.size() < tiles)
+    {
+        stamps.resize(tiles, 0);
+        costs.resize(tiles);
+        cameFrom.resize(tiles);
+        // A path visits each tile once at most, and the heap rarely holds more entries than tiles.
+        open.reserve(tiles);
+        path.reserve(tiles);
+    }
+
+    if (query >= (UINT32_MAX >> 1) - 1)
+    {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        query = 0;
+    }
+    ++query;
+}
+
+template <typename Grid>
+bool Systems::PathFinder::search(const Core::Board& board, const Grid& grid, Utils::Position from, Utils::Position to, int radius)
+{
+    path.clear();
+    expanded = 0;
+    if (!grid.contains(from) || !grid.contains(to)) return false;
+
+    const Utils::GridWindow window = Utils::GridWindow::around(grid, from, radius);
+    const int start = window.indexOf(grid, from);
+    const int goal = window.indexOf(grid, to);
+    if (start < 0 || goal < 0) return false;
+    if (start == goal) return true;
+
+    nextQuery(static_cast<size_t>(window.size()));
+    const std::uint32_t seen = 2 * query;
+    const std::uint32_t closed = seen + 1;
+
+    // Min-heap order: lowest f, then closest to the goal, then tile index so ties never
+    // depend on the heap layout.
+    auto worse = [](const OpenNode& a, const OpenNode& b) {
+        if (a.f != b.f) return a.f > b.f;
+        if (a.h != b.h) return a.h > b.h;
+        return a.tile > b.tile;
+    };
+
+    open.clear();
+    stamps[start] = seen;
+    costs[start] = 0;
+    const int h0 = grid.manhattanDistance(from, to);
+    open.push_back({h0, h0, start});
+
+    while (!open.empty())
+    {
+        std::pop_heap(open.begin(), open.end(), worse);
+        const OpenNode node = open.back();
+        open.pop_back();
+
+        if (stamps[node.tile] == closed || node.f - node.h != costs[node.tile]) continue;
+        stamps[node.tile] = closed;
+        ++expanded;
+
+        if (node.tile == goal) break;
+
+        const Utils::Position pos = window.positionOf(grid, node.tile);
+
+        for (auto dir : {Utils::Direction::UP, Utils::Direction::DOWN, Utils::Direction::LEFT, Utils::Direction::RIGHT})
+        {
+            const Utils::Position next = grid.step(pos, dir);
+            if (next == pos) continue;
+
+            const int tile = window.indexOf(grid, next);
+            if (tile < 0 || stamps[tile] == closed) continue;
+
+            const int cost = costs[node.tile] + 1;
+            if (stamps[tile] == seen && costs[tile] <= cost) continue;
+            if (tile != goal && !board.isTileWalkable(next)) continue;
+
+            stamps[tile] = seen;
+            costs[tile] = cost;
+            cameFrom[tile] = dir;
+
+            const int h = grid.manhattanDistance(next, to);
+            open.push_back({cost + h, h, tile});
+            std::push_heap(open.begin(), open.end(), worse);
+        }
+    }
+
+    if (stamps[goal] != closed) return false;
+
+    // Walk back from the goal, then flip the steps into path order.
+    Utils::Position pos = to;
+    for (int tile = goal; tile != start; tile = window.indexOf(grid, pos))
+    {
+        path.push_back(cameFrom[tile]);
+        pos = grid.step(pos, opposite(cameFrom[tile]));
+    }
+    std::reverse(path.begin(), path.end());
+    return true;
+}
\ No newline at end of file
@@ -1,22 +1,28 @@
 #include "ui/view.h"
 #include "core/game.h"
+#include "core/memoryTracker.h"
 #include "entities/player.h"
 #include "entities/enemy.h"
+#include "entities/entityKinds.h"
+#include <algorithm>
 
 void UI::View::drawBoard(const Core::Game& g) const
 {
     auto& board = g.board;
     auto renderer = g.WindowRenderer.renderer;
 
-    const int tileSize = board->getBoardSizes().tileSize;
-    const int boardSize = board->getBoardSizes().boardSize;
+    const Core::Size size = board->getBoardSizes();
+    const int tileSize = size.tileSize;
+    const int rows = std::min(size.height, g.config.viewTiles);
+    const int cols = std::min(size.width, g.config.viewTiles);
+    const Utils::Position origin = viewOrigin(g);
 
-    for (int i = 0; i < boardSize; ++i)
+    for (int i = 0; i < rows; ++i)
     {
-        for (int j = 0; j < boardSize; ++j)
+        for (int j = 0; j < cols; ++j)
         {
             SDL_Rect cell = { j * tileSize, i * tileSize, tileSize, tileSize };
-            Utils::Position pos(i, j);
+            Utils::Position pos((origin.x + i) % size.height, (origin.y + j) % size.width);
 
             SDL_SetRenderDrawColor(renderer, 255, 255, 233, 255);
             SDL_RenderFillRect(renderer, &cell);
@@ -24,15 +30,47 @@ void UI::View::drawBoard(const Core::Game& g) const
             SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
             SDL_RenderDrawRect(renderer, &cell);
 
-            auto entity = board->getEntityAt(pos);
-            if (entity)
+            if (board->getTerrainAt(pos) == Core::Terrain::WALL)
             {
-                entity->render(g);
+                SDL_SetRenderDrawColor(renderer, 90, 90, 90, 255);
+                SDL_RenderFillRect(renderer, &cell);
+            }
+
+            // Items first, the actor standing on them is drawn over.
+            for (auto layer : {Core::TileLayer::ITEM, Core::TileLayer::ACTOR})
+            {
+                auto entity = g.registry.get(board->getEntityAt(pos, layer));
+                if (entity)
+                    Entities::visit(*entity, [&](auto& e) { e.render(g, cell); });
             }
         }
     }
 }
 
+Utils::Position UI::View::viewOrigin(const Core::Game& g) const
+{
+    const Core::Size size = g.board->getBoardSizes();
+    const int view = g.config.viewTiles;
+
+    // Boards that fit on screen stay fixed, bigger ones scroll with the player: around the
+    // edges on a WRAP board, stopping at them on a BOUNDED one.
+    Utils::Position origin{0, 0};
+    auto player = g.getPlayer();
+    if (!player) return origin;
+
+    auto playerPos = player->getPos();
+    if (size.topology == Core::Topology::BOUNDED)
+    {
+        if (size.height > view) origin.x = std::clamp(playerPos.x - view / 2, 0, size.height - view);
+        if (size.width > view) origin.y = std::clamp(playerPos.y - view / 2, 0, size.width - view);
+        return origin;
+    }
+
+    if (size.height > view) origin.x = (playerPos.x - view / 2 + size.height) % size.height;
+    if (size.width > view) origin.y = (playerPos.y - view / 2 + size.width) % size.width;
+    return origin;
+}
+
 void UI::View::draw(Core::Game& g)
 {
     drawBoard(g);
@@ -41,17 +79,20 @@ void UI::View::draw(Core::Game& g)
 }
 
 void UI::View::drawCombat(Core::Game& g,
-                          std::shared_ptr<Entities::Enemy> mob,
+                          Core::EntityId mob,
                           Systems::Turn currentTurn,
                           int selectedIndex,
                           bool isInventorySelected)
 {
+    auto enemy = g.registry.get<Entities::Enemy>(mob);
+    if (!enemy) return;
+
     SDL_SetRenderDrawColor(g.WindowRenderer.renderer, 0, 0, 0, 255);
     SDL_RenderClear(g.WindowRenderer.renderer);
 
-    drawCombatSprites(g, mob);
-    drawCombatHUD(g, mob);
-    drawCombatTurn(g, mob, currentTurn);
+    drawCombatSprites(g, *enemy);
+    drawCombatHUD(g, *enemy);
+    drawCombatTurn(g, *enemy, currentTurn);
     drawCombatMenu(g, selectedIndex);
 
     if (isInventorySelected)
@@ -60,7 +101,7 @@ void UI::View::drawCombat(Core::Game& g,
     }
 }
 
-void UI::View::drawCombatSprites(Core::Game& g, std::shared_ptr<Entities::Enemy> mob)
+void UI::View::drawCombatSprites(Core::Game& g, Entities::Enemy& mob)
 {
     SDL_Rect playerRect = {100, 200, 128, 128};
     SDL_Rect mobRect = {400, 200, 128, 128};
@@ -74,43 +115,39 @@ void UI::View::drawCombatSprites(Core::Game& g, std::shared_ptr<Entities::Enemy>
                    nullptr, &mobRect);
 }
 
-void UI::View::drawCombatHUD(Core::Game& g, std::shared_ptr<Entities::Enemy> mob)
+void UI::View::drawCombatHUD(Core::Game& g, Entities::Enemy& mob)
 {
-    auto player = g.player;
+    auto player = g.getPlayer();
 
-    std::string playerHpText = "Player HP: " +
-        std::to_string((int)player->getStats().healthPoint) + "/" +
-        std::to_string(player->getStats().maxHp);
+    auto playerHpText = Core::frameText(g.frameArena, "Player HP: ",
+        player->getStats().healthPoint.toIntCeil(), "/", player->getStats().maxHp.toIntCeil());
 
-    std::string mobHpText = "Enemy HP: " +
-        std::to_string((int)mob->getStats().healthPoint) + "/" +
-        std::to_string(mob->getStats().maxHp);
+    auto mobHpText = Core::frameText(g.frameArena, "Enemy HP: ",
+        mob.getStats().healthPoint.toIntCeil(), "/", mob.getStats().maxHp.toIntCeil());
 
-    renderText(g, playerHpText, 100, 150, {0,255,0});
-    renderText(g, mobHpText, 400, 150, {255,0,0});
+    renderText(g, playerHpText.c_str(), 100, 150, {0,255,0});
+    renderText(g, mobHpText.c_str(), 400, 150, {255,0,0});
 }
 
 void UI::View::drawCombatTurn(Core::Game& g,
-                              std::shared_ptr<Entities::Enemy> mob,
+                              Entities::Enemy& mob,
                               Systems::Turn turn)
 {
     if (turn == Systems::Turn::ENEMY)
     {
-        renderText(g,
-                   mob->getName() + " is attacking",
-                   250, 100, {255,0,0});
+        int x = 250;
+        x += renderLabel(g, mob.getNameId(), x, 100, {255,0,0});
+        renderLabel(g, Utils::intern(" is attacking"), x, 100, {255,0,0});
     }
     else
     {
-        renderText(g, "Player turn", 250, 100, {255,255,255});
+        renderLabel(g, Utils::intern("Player turn"), 250, 100, {255,255,255});
     }
 }
 
 void UI::View::drawCombatMenu(Core::Game& g, int selectedIndex)
 {
-    std::vector<std::string> options = {
-        "Attack","Protect","Inventory","Run"
-    };
+    const auto& options = Utils::options;
 
     int menuX = 100;
     int menuY = 400;
@@ -119,10 +156,11 @@ void UI::View::drawCombatMenu(Core::Game& g, int selectedIndex)
     {
         bool selected = (static_cast<int>(i) == selectedIndex);
 
-        std::string line = selected ? "> " + options[i] : "  " + options[i];
         SDL_Color color = selected ? SDL_Color{255,255,0} : SDL_Color{255,255,255};
 
-        renderText(g, line, menuX + i * 200, menuY, color);
+        int x = menuX + i * 200;
+        x += renderLabel(g, Utils::intern(selected ? "> " : "  "), x, menuY, color);
+        renderLabel(g, Utils::intern(options[i]), x, menuY, color);
     }
 
     DisplayRect(g.WindowRenderer.renderer, menuX, menuY, options);
@@ -147,16 +185,13 @@ void UI::View::DisplayRect(SDL_Renderer* renderer,int x, int y,const std::vector
 
 void UI::View::drawInfo(const Core::Game& g) const
 {
-    if(!g.player) return;
-
-    short boardSize = 19;
-    short BoardTileSize = 32;
+    if(!g.getPlayer()) return;
 
-    const int boardPixelsize = boardSize * BoardTileSize;
+    const int boardPixelsize = g.config.boardPixelSize();
 
     SDL_Rect infoBox = {
         boardPixelsize, 0,
-        900 - boardPixelsize, 608
+        g.config.infoPanelWidth, g.config.windowHeight()
     };
 
     SDL_SetRenderDrawColor(g.WindowRenderer.renderer, 50, 50, 50, 255);
@@ -166,90 +201,146 @@ void UI::View::drawInfo(const Core::Game& g) const
 void UI::View::getItemInventory(Core::Game& g)
 {
     int space = 50;
-    auto& items = g.player->getInventory().getItems();
+    auto& items = g.getPlayer()->getInventory().getItems();
 
     if (!items.empty())
     {
-        for (auto& i : items){
-            renderText(g,"> " + i->getName(),0 + space,500,{255,255,255});
+        for (auto id : items){
+            int x = space;
+            x += renderLabel(g, Utils::intern("> "), x, 500, {255,255,255});
+            renderLabel(g, g.registry.get(id)->getNameId(), x, 500, {255,255,255});
             space += 100;
         }
     } else 
-        renderText(g,"- Inventory is empty",50,500,{255,255,255});
+        renderLabel(g, Utils::intern("- Inventory is empty"), 50, 500, {255,255,255});
 }
 
 void UI::View::renderPlayerInfo(Core::Game& g)
 {
-    auto player = g.player;
+    auto player = g.getPlayer();
 
     if (!player) return;
 
-    short boardSize = 19;
-    short BoardTileSize = 32;
-
     SDL_Color white = {255, 255, 255, 255};
     SDL_Color red   = {255, 0, 0, 255};
 
-    int x = boardSize * BoardTileSize + 10;
+    int x = g.config.boardPixelSize() + 10;
     int y = 10;
 
-    auto pos   = player->getPos();
-    auto stats = player->getStats();
+    auto& pos   = player->getPos();
+    auto& stats = player->getStats();
     int nextXp = stats.getXpToNxtLvl();
 
-    auto drawLine = [&](const std::string& text, SDL_Color color = {255, 255, 255, 255}, int offsetX = 0) {
-        renderText(g, text, x + offsetX, y, color);
+    auto drawLine = [&](const Core::ArenaString& text, SDL_Color color = {255, 255, 255, 255}, int offsetX = 0) {
+        renderText(g, text.c_str(), x + offsetX, y, color);
+        y += 30;
+    };
+    auto drawLabel = [&](Utils::NameId label, int offsetX = 0) {
+        renderLabel(g, label, x + offsetX, y, white);
         y += 30;
     };
 
-    drawLine("Position: (" + std::to_string(pos.x) + ", " + std::to_string(pos.y) + ")");
-    drawLine("HP: " + std::to_string(stats.healthPoint));
-    drawLine("Attack: " + std::to_string(stats.attackPoint));
-    drawLine("Defense: " + std::to_string(stats.defensePoint));
-    drawLine("XP: " + std::to_string(stats.xp) +
-            " | Level: " + std::to_string(stats.level) +
-            " | next lvl in: " + std::to_string(nextXp) + " XP");
+    auto& arena = g.frameArena;
+    drawLine(Core::frameText(arena, "Position: (", pos.x, ", ", pos.y, ")"));
+    auto& derived = player->getDerived();
+
+    drawLine(Core::frameText(arena, "HP: ", stats.healthPoint.toIntCeil()));
+    drawLine(Core::frameText(arena, "Attack: ", derived.attack.toInt()));
+    drawLine(Core::frameText(arena, "Defense: ", derived.defense.toInt()));
+    drawLine(Core::frameText(arena, "XP: ", stats.xp,
+            " | Level: ", stats.level,
+            " | next lvl in: ", nextXp, " XP"));
 
 
-    renderText(g, "near Enemy:", x, y, white);
+    renderLabel(g, Utils::intern("near Enemy:"), x, y, white);
 
-    auto enemy = player->getNearEnemy(*g.board);
+    auto enemy = g.registry.get<Entities::Enemy>(player->getNearEnemy(*g.board));
 
     if (enemy) {
-        drawLine(" - " + enemy->getName() +
-                " (HP: " + std::to_string(enemy->getStats().healthPoint) + ")", red, 100);
+        int nameX = x + 100;
+        nameX += renderLabel(g, Utils::intern(" - "), nameX, y, red);
+        nameX += renderLabel(g, enemy->getNameId(), nameX, y, red);
+        renderText(g, Core::frameText(arena, " (HP: ", enemy->getStats().healthPoint.toIntCeil(), ")").c_str(), nameX, y, red);
+        y += 30;
     } else {
-        drawLine(" - None", white, 100);
+        drawLabel(Utils::intern(" - None"), 100);
     }
 
     y += 20;
 
-    drawLine("Inventory:");
+    drawLabel(Utils::intern("Inventory:"));
 
-    auto items = player->getInventory().getItems();
+    auto& items = player->getInventory().getItems();
 
     if (items.empty()) {
-        drawLine(" - (Empty)");
+        drawLabel(Utils::intern(" - (Empty)"));
     } else {
-        for (const auto& item : items) {
-            drawLine(" - " + item->getName());
-            y -= 5;
+        for (auto item : items) {
+            int nameX = x + renderLabel(g, Utils::intern(" - "), x, y, white);
+            renderLabel(g, g.registry.get(item)->getNameId(), nameX, y, white);
+            y += 25;
         }
     }   
 }
 
-void UI::View::renderText(const Core::Game& g, const std::string& text,
+void UI::View::renderText(const Core::Game& g, const char* text,
                 int x, int y, SDL_Color c)
 {
-    SDL_Surface* surface = TTF_RenderText_Solid(g.WindowRenderer.font, text.c_str(), c );
+    SDL_Surface* surface = TTF_RenderText_Solid(g.WindowRenderer.font, text, c );
 	if (!surface) return;
 
+	// Surface and texture only live for this call, they show up in the allocation count and peak.
+	const size_t bytes = static_cast<size_t>(surface->pitch) * surface->h + static_cast<size_t>(surface->w) * surface->h * 4;
+	Core::memory().onAllocate(Core::MemoryTag::TEXT, bytes);
+
 	SDL_Texture* texture = SDL_CreateTextureFromSurface(g.WindowRenderer.renderer, surface);
 	SDL_Rect destRect = { x, y, surface->w, surface->h };
 	SDL_RenderCopy(g.WindowRenderer.renderer, texture, nullptr, &destRect);
 
 	SDL_FreeSurface(surface);
 	SDL_DestroyTexture(texture);
+	Core::memory().onFree(Core::MemoryTag::TEXT, bytes);
+}
+
+int UI::View::renderLabel(const Core::Game& g, Utils::NameId label,
+                          int x, int y, SDL_Color c)
+{
+    const std::uint64_t key = (std::uint64_t(label) << 32) |
+        (std::uint32_t(c.r) << 24) | (std::uint32_t(c.g) << 16) |
+        (std::uint32_t(c.b) << 8) | c.a;
+
+    auto it = textCache.find(key);
+    if (it == textCache.end())
+    {
+        SDL_Surface* surface = TTF_RenderText_Solid(g.WindowRenderer.font, Utils::nameOf(label).c_str(), c);
+        if (!surface) return 0;
+
+        CachedText text{SDL_CreateTextureFromSurface(g.WindowRenderer.renderer, surface), surface->w, surface->h};
+        SDL_FreeSurface(surface);
+        if (!text.texture) return 0;
+
+        // Over the cap, start the cache over rather than letting it grow.
+        const size_t bytes = static_cast<size_t>(text.w) * text.h * 4;
+        if (Core::memory().wouldExceed(Core::MemoryTag::TEXT, bytes)) clearTextCache();
+
+        Core::memory().onAllocate(Core::MemoryTag::TEXT, bytes);
+        it = textCache.emplace(key, text).first;
+    }
+
+    SDL_Rect destRect = { x, y, it->second.w, it->second.h };
+    SDL_RenderCopy(g.WindowRenderer.renderer, it->second.texture, nullptr, &destRect);
+    return it->second.w;
+}
+
+void UI::View::clearTextCache()
+{
+    for (auto& [key, text] : textCache)
+    {
+        Core::memory().onFree(Core::MemoryTag::TEXT, static_cast<size_t>(text.w) * text.h * 4);
+        SDL_DestroyTexture(text.texture);
+    }
+
+    textCache.clear();
 }
 
 void UI::View::drawTitleScreen(const Core::Game& g)
@@ -258,9 +349,9 @@ void UI::View::drawTitleScreen(const Core::Game& g)
     SDL_RenderClear(g.WindowRenderer.renderer);
     SDL_Color white = {255, 255, 255, 255};
 
-    renderText(g, "Mini RPG Game", 350, 200,white);
-    renderText(g, "Press SPACE to start", 300, 300,white);
-    renderText(g,"-personal project-",420,570,white);
+    renderLabel(g, Utils::intern("Mini RPG Game"), 350, 200,white);
+    renderLabel(g, Utils::intern("Press SPACE to start"), 300, 300,white);
+    renderLabel(g, Utils::intern("-personal project-"),420,570,white);
 }
 
 void UI::View::drawPauseScreen(const Core::Game& g)
@@ -269,8 +360,8 @@ void UI::View::drawPauseScreen(const Core::Game& g)
     SDL_RenderClear(g.WindowRenderer.renderer);
     SDL_Color white = {255, 255, 255, 255};
 
-    renderText(g,"PAUSE",400,200,white);
-    renderText(g,"Press ENTER to quit the game",260,300,white);
+    renderLabel(g, Utils::intern("PAUSE"),400,200,white);
+    renderLabel(g, Utils::intern("Press ENTER to quit the game"),260,300,white);
 }
 
 void UI::View::drawGameOverScreen(const Core::Game& g)
@@ -279,6 +370,6 @@ void UI::View::drawGameOverScreen(const Core::Game& g)
     SDL_RenderClear(g.WindowRenderer.renderer);
     SDL_Color white = {255, 255, 255, 255};
 
-    renderText(g,"GAME OVER",350,200,white);
-    renderText(g,"Press ENTER to quit the game",260,300,white);
+    renderLabel(g, Utils::intern("GAME OVER"),350,200,white);
+    renderLabel(g, Utils::intern("Press ENTER to quit the game"),260,300,white);
 }
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "utils/nameTable.h"
+#include <iostream>
+
+Utils::NameTable::NameTable()
+{
+    strings.emplace_back();
+    ids.emplace(strings.back(), 0);
+}
+
+Utils::NameId Utils::NameTable::intern(std::string_view text)
+{
+    auto it = ids.find(text);
+    if (it != ids.end()) return it->second;
+
+    NameId id = static_cast<NameId>(strings.size());
+    strings.emplace_back(text);
+    ids.emplace(strings.back(), id);
+    return id;
+}
+
+const std::string& Utils::NameTable::str(NameId id) const
+{
+    if (id >= strings.size())
+    {
+        std::cerr << "Unknown name id: " << id << std::endl;
+        return strings.front();
+    }
+    return strings[id];
+}
+
+Utils::NameTable& Utils::nameTable()
+{
+    static NameTable table;
+    return table;
+}
\ No newline at end of file
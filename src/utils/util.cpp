@@ -1,109 +1,64 @@
 #include "utils/util.h"
+#include "utils/grid.h"
 
 
-Utils::Direction Utils::getRandDir()
+std::uint32_t Utils::mix(std::uint64_t a, std::uint64_t b)
 {
-    int nbr = rand() % 4;
-
-    switch (nbr)
-    {
-    case 0:
-        return Utils::Direction::DOWN;
-        break;
-    case 1:
-        return Utils::Direction::UP;
-        break;
-    case 2:
-        return Utils::Direction::LEFT;
-        break;
-    case 3:
-        return Utils::Direction::RIGHT;
-        break;
-    default:
-        return Utils::Direction::UP;
-        break;
-    }
+    std::uint64_t z = a * 0x9E3779B97F4A7C15ull + b;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<std::uint32_t>((z ^ (z >> 31)) >> 32);
 }
 
-void Utils::HealPlayerOnItem(std::shared_ptr<Entities::Player> player, Core::Board& board, Utils::Position pos) {
-	auto entity = board.getEntityAt(pos).get();
-	auto healItem = dynamic_cast<Entities::HealItem*>(entity);
+void Utils::HealPlayerOnItem(Entities::Player& player, Core::Board& board, Utils::Position pos) {
+	auto healItem = board.getRegistry().get<Entities::HealItem>(board.getEntityAt(pos, Core::TileLayer::ITEM));
 	if (healItem) {
-		player->heal(healItem->getAmmount());
+		player.heal(healItem->getAmmount());
 	}
 }
 
-Utils::Position Utils::getDirection(int posX, int posY, Utils::Direction dir)
+Utils::Position Utils::getDirection(int posX, int posY, Utils::Direction dir, const Core::Size& size)
 {
-	
-    int boardsize = 19;
-
-    switch (dir)
-	{
-	case Utils::Direction::RIGHT:
-		posY += 1;
-		if (posY >= boardsize) posY = 0;
-		break;
-	case Utils::Direction::LEFT:
-		posY -= 1;
-		if (posY < 0) posY = boardsize -1;
-		break;
-	case Utils::Direction::UP:
-		posX -= 1;
-		if (posX < 0) {
-			posX = boardsize - 1;
-		}
-		break;
-	case Utils::Direction::DOWN:
-		posX += 1;
-		if (posX >= boardsize) {
-        	posX = 0;
-    	}
-	default:
-		break;
-	}
-	return { posX, posY };
+    return withGrid(size, [&](const auto& grid) { return grid.step({posX, posY}, dir); });
 }
 
-int Utils::calculateDistance(std::shared_ptr<Entities::Enemy> e, std::shared_ptr<Entities::Player> p)
+Utils::NameId Utils::generateRandomName()
 {
-    return sqrt( ( pow( (p->getPos().x - e->getPos().x), 2) + pow( (p->getPos().y - e->getPos().y), 2) ) );
+    return intern(names[rand() % 8]);
 }
 
-std::string Utils::generateRandomName()
-{
-    return names[rand() % 8];
-}
-
-Utils::Position Utils::generateRandomPosition(Core::Board& board)
+bool Utils::generateRandomPosition(Core::Board& board, Position& pos)
 {
     std::random_device rd; 
     std::mt19937 eng(rd());
-    std::uniform_int_distribution<> distr(0, board.getBoardSizes().boardSize - 1);
 
-    int x = distr(eng);
-    int y = distr(eng);
+    // Only pick tiles in memory, spawning far away would load (and keep) a distant chunk.
+    const Core::Size size = board.getBoardSizes();
+    const Core::TileArea area = board.getResidentArea();
+    std::uniform_int_distribution<> distrX(0, area.height - 1);
+    std::uniform_int_distribution<> distrY(0, area.width - 1);
 
-    if (board.getEntityTypeAt({x,y}) != Entities::EntityType::NONE) {
-        do {
-            x = distr(eng);
-            y = distr(eng);
-        } while (board.getEntityTypeAt({x,y}) == Entities::EntityType::NONE);
-    }
-    return { x , y };
-}
+    auto at = [&](int row, int col) -> Utils::Position {
+        return { (area.origin.x + row) % size.height, (area.origin.y + col) % size.width };
+    };
+    auto isFree = [&](Utils::Position p) { return board.isTileEmpty(p) && board.isTileResident(p); };
 
-std::vector<std::shared_ptr<Entities::HealItem>> Utils::getHealInBoard(Core::Board& board) {
-    std::vector<std::shared_ptr<Entities::HealItem>> Heals;
-    auto allEntities = board.getEntities();
+    // Random draws find a tile quickly unless the area is nearly full.
+    constexpr int randomAttempts = 64;
+    for (int attempt = 0; attempt < randomAttempts; ++attempt)
+    {
+        pos = at(distrX(eng), distrY(eng));
+        if (isFree(pos)) return true;
+    }
 
-    for (auto& e : allEntities) {
-        if (e->getType() == Entities::EntityType::HEAL) {
-            auto heal = std::dynamic_pointer_cast<Entities::HealItem>(e);
-            if (heal) {
-                Heals.push_back(heal);
-            }
-        }
+    // Then one pass over the area, from a random tile so spawns do not pile up in a corner.
+    const int tiles = area.height * area.width;
+    const int start = std::uniform_int_distribution<>(0, tiles - 1)(eng);
+    for (int i = 0; i < tiles; ++i)
+    {
+        const int tile = (start + i) % tiles;
+        pos = at(tile / area.width, tile % area.width);
+        if (isFree(pos)) return true;
     }
-    return Heals;
+    return false;
 }
\ No newline at end of file
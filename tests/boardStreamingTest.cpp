@@ -0,0 +1,171 @@
+#include "core/board.h"
+#include "entities/enemy.h"
+#include "entities/healItem.h"
+#include "utils/util.h"
+#include <iostream>
+
+namespace {
+
+    int failures = 0;
+
+    void check(bool ok, const char* what)
+    {
+        if (ok) return;
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+
+    /// Chunks further than one chunk from the center go to disk, in the default directory.
+    Core::StreamingConfig streaming()
+    {
+        Core::StreamingConfig config;
+        config.residentRadius = 1;
+        return config;
+    }
+
+    /// 256 x 256 board (8 x 8 chunks), the player in the top-left chunk and an enemy in the
+    /// bottom-left one, only an edge away on a WRAP board.
+    void residencyAtTheEdge(Core::Topology topology)
+    {
+        const bool wrap = topology == Core::Topology::WRAP;
+        Core::Size size;
+        size.width = size.height = 256;
+        size.topology = topology;
+
+        Core::EntityRegistry registry;
+        Core::Board board(registry, size, streaming());
+
+        const Utils::Position bottom{250, 4};
+        board.setEntityAt(bottom, registry.create<Entities::Enemy>(Utils::intern("Edge"), Entities::Stats(5, 1, 1), Utils::Position{0, 0}));
+        board.updateResidency({4, 4});
+
+        if (wrap)
+        {
+            check(board.isTileResident(bottom), "wrap: the chunk across the top edge is resident");
+            check(board.enemyCount() == 1, "wrap: the enemy across the top edge stays loaded");
+
+            const Core::TileArea area = board.getResidentArea();
+            check(area.origin.x == 224 && area.origin.y == 224, "wrap: the resident area starts across the edges");
+            check(area.height == 96 && area.width == 96, "wrap: the resident area spans 3 x 3 chunks");
+        }
+        else
+        {
+            check(!board.isTileResident(bottom), "bounded: the chunk at the opposite edge is not resident");
+            check(board.enemyCount() == 0, "bounded: the enemy at the opposite edge is streamed out");
+            check(board.getLoadedChunkCount() == 0, "bounded: no chunk is loaded past the edge");
+
+            const Core::TileArea area = board.getResidentArea();
+            check(area.origin.x == 0 && area.origin.y == 0, "bounded: the resident area starts at the board corner");
+            check(area.height == 64 && area.width == 64, "bounded: the resident area is cut at the edges");
+
+            // Coming back loads it again.
+            board.updateResidency(bottom);
+            check(board.enemyCount() == 1, "bounded: the enemy comes back with its chunk");
+        }
+    }
+
+    /// Moves never bring a chunk back from disk, only updateResidency does.
+    void movesStayResident()
+    {
+        Core::Size size;
+        size.width = size.height = 256;
+
+        Core::EntityRegistry registry;
+        Core::Board board(registry, size, streaming());
+
+        // An enemy at the bottom edge of the resident window, one chunk on disk below it.
+        const Utils::Position edge{95, 40};
+        const Utils::Position below{96, 40};
+        board.setEntityAt({100, 40}, registry.create<Entities::Enemy>(Utils::intern("Far"), Entities::Stats(5, 1, 1), Utils::Position{0, 0}));
+        board.setEntityAt(edge, registry.create<Entities::Enemy>(Utils::intern("Edge"), Entities::Stats(5, 1, 1), Utils::Position{0, 0}));
+        board.updateResidency({40, 40});
+        const size_t loaded = board.getLoadedChunkCount();
+
+        check(board.moveEntity(edge, below) == Core::MoveResult::OCCUPIED, "moveEntity: a non-resident target is blocked");
+
+        const Core::Move move{edge, below};
+        Core::MoveResult result = Core::MoveResult::MOVED;
+        board.applyMoves({&move, 1}, {&result, 1});
+        check(result == Core::MoveResult::OCCUPIED, "applyMoves: a non-resident target is blocked");
+        check(board.getLoadedChunkCount() == loaded, "moves load no chunk");
+        check(board.enemyCount() == 1, "the enemy on disk stays there");
+    }
+
+    /// Boards of one process keep their chunks apart: a second board neither clears nor
+    /// overwrites what the first one streamed out.
+    void boardsKeepTheirChunks()
+    {
+        Core::Size size;
+        size.width = size.height = 256;
+
+        Core::EntityRegistry registry;
+        Core::Board first(registry, size, streaming());
+        first.setEntityAt({200, 200}, registry.create<Entities::Enemy>(Utils::intern("First"), Entities::Stats(5, 1, 1), Utils::Position{0, 0}));
+        first.updateResidency({0, 0});
+        check(first.enemyCount() == 0, "first board: the far enemy is streamed out");
+
+        {
+            Core::Board second(registry, size, streaming());
+            second.setEntityAt({200, 200}, registry.create<Entities::HealItem>(Utils::intern("Second"), 5, Utils::Position{0, 0}));
+            second.updateResidency({0, 0});
+        }
+
+        first.updateResidency({200, 200});
+        check(first.enemyCount() == 1 && first.healCount() == 0, "first board: its own enemy comes back, not the other board's item");
+    }
+
+    /// Entities streamed out still count in the totals the respawns go by.
+    void totalsCountChunksOnDisk()
+    {
+        Core::Size size;
+        size.width = size.height = 256;
+
+        Core::EntityRegistry registry;
+        Core::Board board(registry, size, streaming());
+        board.setEntityAt({10, 10}, registry.create<Entities::Enemy>(Utils::intern("Near"), Entities::Stats(5, 1, 1), Utils::Position{0, 0}));
+        board.setEntityAt({200, 200}, registry.create<Entities::Enemy>(Utils::intern("Far"), Entities::Stats(5, 1, 1), Utils::Position{0, 0}));
+        board.setEntityAt({201, 200}, registry.create<Entities::HealItem>(Utils::intern("Heal"), 5, Utils::Position{0, 0}));
+
+        board.updateResidency({0, 0});
+        check(board.enemyCount() == 1 && board.healCount() == 0, "only the near enemy is loaded");
+        check(board.totalCountOf(Entities::EntityType::ENEMY) == 2, "the enemy on disk still counts");
+        check(board.totalCountOf(Entities::EntityType::HEAL) == 1, "the heal on disk still counts");
+
+        board.updateResidency({200, 200});
+        check(board.totalCountOf(Entities::EntityType::ENEMY) == 2, "enemies are not counted twice once loaded back");
+        check(board.totalCountOf(Entities::EntityType::HEAL) == 1 && board.healCount() == 1, "the heal is loaded back once");
+    }
+
+    /// A resident area with no free tile makes the spawn fail instead of looping.
+    void spawnOnFullBoard()
+    {
+        Core::Size size;
+        size.width = size.height = 8;
+
+        Core::EntityRegistry registry;
+        Core::Board board(registry, size);
+        for (int x = 0; x < size.height; ++x)
+            for (int y = 0; y < size.width; ++y)
+                board.setTerrainAt({x, y}, Core::Terrain::WALL);
+        board.setTerrainAt({3, 5}, Core::Terrain::FLOOR);
+
+        Utils::Position pos;
+        check(Utils::generateRandomPosition(board, pos) && pos == Utils::Position{3, 5}, "the only free tile is found");
+
+        board.setTerrainAt({3, 5}, Core::Terrain::WALL);
+        check(!Utils::generateRandomPosition(board, pos), "no free tile makes the spawn fail");
+    }
+}
+
+int main()
+{
+    residencyAtTheEdge(Core::Topology::WRAP);
+    residencyAtTheEdge(Core::Topology::BOUNDED);
+    movesStayResident();
+    boardsKeepTheirChunks();
+    totalsCountChunksOnDisk();
+    spawnOnFullBoard();
+
+    if (failures == 0) std::cout << "boardStreamingTest passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include "core/game.h"
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+    int failures = 0;
+
+    void check(bool ok, const char* what)
+    {
+        if (ok) return;
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+
+    Core::EntityId spawnEnemy(Core::Board& board, Core::EntityRegistry& registry, Utils::Position pos)
+    {
+        Core::EntityId enemy = registry.create<Entities::Enemy>(Utils::intern("E"), Entities::Stats(5, 1, 1), Utils::Position{0, 0});
+        board.setEntityAt(pos, enemy);
+        return enemy;
+    }
+
+    /// The same seeded board for every game: walls, the player in the middle and a tenth of
+    /// the tiles holding enemies.
+    void buildGame(Core::Game& g, int threads, Core::Topology topology)
+    {
+        const int side = 32;
+        g.config.board.width = g.config.board.height = side;
+        g.config.board.topology = topology;
+        g.board = std::make_unique<Core::Board>(g.registry, g.config.board);
+        g.board->getJournal().setEnabled(true);
+        g.entityManager = std::make_unique<Core::EntityManager>(threads);
+
+        std::mt19937 rng(42);
+        for (int i = 0; i < side * side / 8; ++i)
+            g.board->setTerrainAt({int(rng() % side), int(rng() % side)}, Core::Terrain::WALL);
+
+        g.player = g.registry.create<Entities::Player>(Utils::Position{0, 0});
+        g.board->setTerrainAt({side / 2, side / 2}, Core::Terrain::FLOOR);
+        g.board->setEntityAt({side / 2, side / 2}, g.player);
+
+        for (int placed = 0; placed < side * side / 10;)
+        {
+            Utils::Position pos{int(rng() % side), int(rng() % side)};
+            if (!g.board->isTileEmpty(pos)) continue;
+            spawnEnemy(*g.board, g.registry, pos);
+            ++placed;
+        }
+        g.board->getJournal().nextTick();
+    }
+
+    /// Runs the enemy tick with pools of 1, 4 and 32 workers on identical boards. Every tick
+    /// must leave each entity on the same tile and start the same fight, whatever the pool.
+    void sameTickOnEveryPool(Core::Topology topology)
+    {
+        const std::vector<int> poolSizes = {1, 4, 32};
+        std::vector<std::unique_ptr<Core::Game>> games;
+        for (int threads : poolSizes) {
+            games.push_back(std::make_unique<Core::Game>());
+            buildGame(*games.back(), threads, topology);
+        }
+
+        std::mt19937 rng(7);
+        int fights = 0;
+        bool samePositions = true, sameFights = true;
+
+        for (int tick = 0; tick < 200; ++tick)
+        {
+            const auto playerDir = static_cast<Utils::Direction>(rng() % 4);
+            const std::uint32_t stagger = rng();
+
+            for (auto& game : games)
+            {
+                Core::Game& g = *game;
+                g.entityManager->flowField.applyChanges(*g.board, g.board->getJournal().getChanges());
+                g.board->getJournal().nextTick();
+
+                // About a quarter of the enemies sit the tick out, a different quarter each time.
+                auto& c = g.registry.getComponents();
+                for (std::uint32_t i = 0; i < c.size(); ++i)
+                    c.nextActionTimes[i] = ((i * 2654435761u ^ stagger) & 3) == 0 ? 0x7fffffffu : 0;
+
+                g.state = Core::GameState::GAMEPLAY;
+                g.currentEnemy = {};
+                g.entityManager->enemyAlgorithm(g);
+            }
+
+            const Core::Game& ref = *games.front();
+            const auto& refComponents = ref.registry.getComponents();
+            fights += ref.state == Core::GameState::FIGHT;
+
+            for (size_t k = 1; k < games.size(); ++k)
+            {
+                const Core::Game& g = *games[k];
+                const auto& c = g.registry.getComponents();
+
+                sameFights &= g.state == ref.state && g.currentEnemy == ref.currentEnemy;
+                samePositions &= c.size() == refComponents.size();
+                for (std::uint32_t i = 0; samePositions && i < c.size(); ++i)
+                    samePositions &= c.positions[i] == refComponents.positions[i];
+            }
+
+            for (auto& game : games)
+            {
+                Core::Game& g = *game;
+                g.state = Core::GameState::GAMEPLAY;
+                g.getPlayer()->move(g, playerDir);
+                g.commands.apply(*g.board);
+            }
+        }
+
+        check(samePositions, "every pool size moves the enemies to the same tiles");
+        check(sameFights, "every pool size starts the same fight");
+        check(fights > 0, "the enemies reach the player at least once");
+    }
+
+    /// Conflicts go to the smallest source whatever the order of the batch, chains and
+    /// rotations move everyone.
+    void applyMovesResolvesConflicts(Core::BoardBackend backend)
+    {
+        Core::EntityRegistry registry;
+        Core::Size size;
+        size.width = size.height = 8;
+        size.topology = Core::Topology::BOUNDED;
+        Core::Board board(registry, size, {}, backend);
+
+        // Both step onto (2, 3), the larger source comes first in the batch.
+        Core::EntityId left = spawnEnemy(board, registry, {2, 2});
+        Core::EntityId right = spawnEnemy(board, registry, {2, 4});
+        {
+            const Core::Move moves[] = {{{2, 4}, {2, 3}}, {{2, 2}, {2, 3}}};
+            Core::MoveResult results[2];
+            board.applyMoves(moves, results);
+            check(results[1] == Core::MoveResult::MOVED, "the smallest source wins the target");
+            check(results[0] == Core::MoveResult::CONFLICT, "the other move reports the conflict");
+            check(board.getEntityAt({2, 3}, Core::TileLayer::ACTOR) == left, "the winner is on the target");
+            check(board.getEntityAt({2, 4}, Core::TileLayer::ACTOR) == right, "the loser stays home");
+        }
+
+        // The head of the chain comes first, its target is only freed by the next move.
+        Core::EntityId head = spawnEnemy(board, registry, {4, 1});
+        Core::EntityId tail = spawnEnemy(board, registry, {4, 2});
+        {
+            const Core::Move moves[] = {{{4, 1}, {4, 2}}, {{4, 2}, {4, 3}}};
+            Core::MoveResult results[2];
+            board.applyMoves(moves, results);
+            check(results[0] == Core::MoveResult::MOVED && results[1] == Core::MoveResult::MOVED, "a chain moves everyone");
+            check(board.getEntityAt({4, 2}, Core::TileLayer::ACTOR) == head, "the head follows the chain");
+            check(board.getEntityAt({4, 3}, Core::TileLayer::ACTOR) == tail, "the tail leads the chain");
+            check(!board.getEntityAt({4, 1}, Core::TileLayer::ACTOR), "the chain leaves its start empty");
+        }
+
+        // Four enemies turning around a 2 x 2 square, every target is held by a mover.
+        const Utils::Position ring[] = {{6, 1}, {6, 2}, {7, 2}, {7, 1}};
+        Core::EntityId ringIds[4];
+        for (int i = 0; i < 4; ++i) ringIds[i] = spawnEnemy(board, registry, ring[i]);
+        {
+            Core::Move moves[4];
+            for (int i = 0; i < 4; ++i) moves[i] = {ring[i], ring[(i + 1) % 4]};
+            Core::MoveResult results[4];
+            board.applyMoves(moves, results);
+
+            bool allMoved = true, allTurned = true;
+            for (int i = 0; i < 4; ++i) {
+                allMoved &= results[i] == Core::MoveResult::MOVED;
+                allTurned &= board.getEntityAt(ring[(i + 1) % 4], Core::TileLayer::ACTOR) == ringIds[i];
+            }
+            check(allMoved, "a rotation moves everyone");
+            check(allTurned, "a rotation turns every enemy by one tile");
+        }
+    }
+}
+
+int main()
+{
+    sameTickOnEveryPool(Core::Topology::WRAP);
+    sameTickOnEveryPool(Core::Topology::BOUNDED);
+    applyMovesResolvesConflicts(Core::BoardBackend::DENSE);
+    applyMovesResolvesConflicts(Core::BoardBackend::SPARSE);
+
+    if (failures == 0) std::cout << "enemyTickTest passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file